@@ -10,9 +10,10 @@ Template classes need to be defined completely in the .h file. */
 #include <vector>
 #include <deque>
 #include <random>
-#include <chrono>
 #include <cmath>
 
+#include "Rng_stream.h"
+
 template <typename T>
 class Alias_table
 {
@@ -44,7 +45,7 @@ Alias_table<T>::Alias_table() {}
 
 template<typename T>
 Alias_table<T>::Alias_table(std::vector<T> in_outcomes, std::vector<double> in_probabilities) :
-    MT_generator(std::chrono::system_clock::now().time_since_epoch().count()),
+    MT_generator(Rng_stream::current().draw_seed()), // seeded from the calling thread's stream
     unif_distribution(0.0, 1.0)
 {
     init(in_outcomes, in_probabilities);
@@ -7,7 +7,7 @@ Control_manager::Control_manager(const Parameters* p_in, Grid_manager* G_in)
 	:
 	p(p_in),
 	gridManager(G_in),
-	allPrems(gridManager->get_allFarms())
+	allPrems(&gridManager->get_allFarms_vector())
 {
 	verbose = verboseLevel;
 if (p->control_on == true){
@@ -293,7 +293,7 @@ void Control_manager::apply_rule(std::vector<Prem_status*>* reported, const cont
 		// if applying to farms in 'reported'
 		if (rule.target == 0){
 			for (auto& rp:(*reported)){
-				Farm* f = allPrems->at(rp->Farm::get_id()); // convert Prem_status* to Farm*
+				Farm* f = (*allPrems)[rp->Farm::get_ordinal()]; // convert Prem_status* to Farm*
 				input.emplace_back(f);
 			}
 			prioritize(rule.priority, input, tempOutput);
@@ -311,26 +311,13 @@ if(verbose>1 && DCs.size()>0){std::cout<<"Farm has "<<DCs.size()<<" dangerous co
 
 		// if applying to neighbors within radius
 		} else if (rule.target > 0){ // if any other positive number, get farms in that radius from reported, could prioritize by closest
-			bool distanceRequired = 0;
-			if (rule.priority.compare("closest") == 0){
-				distanceRequired = 1;
-			} // if not required, some neighbors in-cell may have distance = -1
-
-			std::multimap<double, Farm*> allTargets;
+			std::vector<Farm*> reportedFarms;
+			reportedFarms.reserve(reported->size());
 			for (auto& rp:(*reported)){
-				Farm* f = allPrems->at(rp->Farm::get_id()); // convert Prem_status* to Farm*
-				std::multimap<double, Farm*> neighborsOfRP;
-				gridManager->get_neighborsInRadius(f, rule.target, rule.radiusSquared,
-																					 distanceRequired, neighborsOfRP);
-				allTargets.insert(neighborsOfRP.begin(), neighborsOfRP.end()); // sorted by distance to ANY reported premises
-			}
-			// remove duplicates by only adding to vector if not already present
-			for (auto& n:allTargets){ // n is for neighbor
-				auto inVector = std::find(input.begin(), input.end(), n.second);
-				if (inVector == input.end()){ // not already in vector
-					input.emplace_back(n.second);
-				}
+				reportedFarms.emplace_back((*allPrems)[rp->Farm::get_ordinal()]); // convert Prem_status* to Farm*
 			}
+			// each neighbor once, sorted by distance to the closest reported premises
+			gridManager->get_neighborsInRadius(reportedFarms, rule.target, rule.radiusSquared, input);
 			prioritize(rule.priority, input, tempOutput);
 		}
 	}
@@ -48,7 +48,7 @@ class Control_manager
 		int verbose; ///< Can be set to override global setting for console output
 		const Parameters* p;
 		Grid_manager* gridManager; // not const because neighbor calculations can change during simulations
-		const std::unordered_map<int, Farm*>* allPrems;
+		const std::vector<Farm*>* allPrems; ///< All premises, by ordinal
 
 		std::unordered_map<std::string, controlType*> allControlTypes; /// Key = name of control type, value = controlType struct
 		std::unordered_map<std::string, std::unordered_map<std::string, Control_resource*>> controlResources; /// Map of all control resources - first key by control type, second key by ID (state, cellID, etc). Value is Control_resource
@@ -10,15 +10,16 @@
 #include "State.h"
 #include "File_manager.h"
 
-Farm::Farm(int in_id, double in_x, double in_y, std::string in_fips)
+Farm::Farm(int in_id, int in_ordinal, double in_x, double in_y, std::string in_fips)
 	:
 	id(in_id),
+	ordinal(in_ordinal),
 	cellID(-1),
+	cellIndex(-1),
 	x_coordinate(in_x),
 	y_coordinate(in_y),
 	position(in_x, in_y),
-	fips(in_fips),
-	neighborRadiusCalculated(0)
+	fips(in_fips)
 {
 }
 
@@ -58,9 +59,10 @@ int Farm::get_size_allSpecies() const
   return count;
 }
 
-void Farm::set_cellID(const int in_cellID)
+void Farm::set_cellID(const int in_cellID, const int in_cellIndex)
 {
 	cellID = in_cellID;
+	cellIndex = in_cellIndex;
 }
 
 void Farm::set_farm_type(Farm_type* in_type)
@@ -103,21 +105,11 @@ void Farm::set_parent_county(County* in_county)
   parent_county = in_county;
 }
 
-/// Sets distances-neighbors map via swap
-void Farm::set_distancesNeighbors(std::multimap<double, Farm*>& dn)
-{
-	distancesNeighbors.swap(dn);
-}
-
 State* Farm::get_parent_state() const
 {
     return parent_county->get_parent_state();
 }
 
-void Farm::set_neighborRadiusCalculated(const double radius)
-{
-	neighborRadiusCalculated = radius;
-}
 
 
 Farm_type::Farm_type(std::string herd, std::vector<std::string> in_species, unsigned int index) :
@@ -144,8 +136,8 @@ Farm_type::~Farm_type()
 Prem_status::Prem_status(Farm* f)
 	:
 	Farm(*f), // call copy constructor of Farm to fill in all other members
-	fileStatus("notDangerousContact"),
-	diseaseStatus("sus"),
+	fileStatus(statusNotDC),
+	diseaseStatus(statusSus),
 	isVaccinated(false),
 	currentSizeUnvaccinated(speciesCounts)
 {
@@ -157,22 +149,29 @@ Prem_status::~Prem_status()
 {
 }
 
-int Prem_status::get_start(std::string s) const
-{
-	int output = -1;
-	if (start.count(s) > 0){
-		output = start.at(s);
-	}
-	return output;
-}
-
-int Prem_status::get_end(std::string s) const
-{
-	int output = -1;
-	if (end.count(s) > 0){
-		output = end.at(s);
-	}
-	return output;
+/// Same result as constructing a new Prem_status from f, but the containers keep their
+/// capacity, so reusing an object from a previous replicate rarely allocates.
+void Prem_status::reset(Farm* f)
+{
+	Farm::operator=(*f);
+	fileStatus = statusNotDC;
+	diseaseStatus = statusSus;
+	controlStatuses.clear();
+	statusWhenWaitlisted.clear();
+	start.clear();
+	end.clear();
+	listEntry.clear();
+	probPreventExposure.assign(1, 0.0);
+	probPreventTransmission.assign(1, 0.0);
+	dangerousContacts.clear();
+	potentialDCs.clear();
+	expTime.clear();
+	expSource.clear();
+	expRoute.clear();
+	expBlocked.clear();
+	isVaccinated = false;
+	currentSize.clear();
+	currentSizeUnvaccinated = speciesCounts;
 }
 
 /// Returns the probability that exposure of a premises is prevented, based on the
@@ -258,28 +257,14 @@ const std::unordered_map<std::string, int>& Prem_status::get_currentSizeUnvaccin
 }
 
 /// Stores info for determining if potential DCs will be dangerousContacts
-void Prem_status::add_potentialDCInfo(Farm* pdc, const std::unordered_map<std::string, bool>& dcInfo)
+/// \param[in] pdc Potential dangerous contact
+/// \param[in] dcInfo Bit s set if pdc is a dangerous contact when its disease status is s
+void Prem_status::add_potentialDCInfo(Farm* pdc, unsigned int dcInfo)
 {
-	if (potentialDCs.count(pdc)==0){
-		potentialDCs[pdc] = dcInfo;
-		if(verboseLevel>1){std::cout<<"F in Prem_status add_potentialDCInfo first if statement"<<std::endl;}
-
-	} else { // in case DC relationship already established between this pair of farms,
-	         // isDC status of 'true' should override any 'false' evaluations
-		if(verboseLevel>1){std::cout<<"F in Prem_status add_potentialDCInfo first if statement else"<<std::endl;}
-
-if(verboseLevel>1){std::cout<<"DC relationship already established, new values: ";}
-		std::unordered_map<std::string, bool> existingPDC = potentialDCs.at(pdc);
-		for (auto& s:existingPDC){ //s.first is status (i.e. sus, exp); s.second is bool
-			if (dcInfo.at(s.first)==1){
-				potentialDCs.at(pdc).at(s.first) = 1;
-				if(verboseLevel>1){std::cout<<"F in Prem_status add_potentialDCInfo for loop"<<std::endl;}
-
-			}
-if(verboseLevel>1){std::cout<<s.first<<"="<<potentialDCs.at(pdc).at(s.first)<<", ";}
-		}
-if(verboseLevel>1){std::cout<<std::endl;}
-	}
+	// in case DC relationship already established between this pair of farms,
+	// isDC status of 'true' should override any 'false' evaluations
+if(verboseLevel>1 && potentialDCs.count(pdc)>0){std::cout<<"DC relationship already established"<<std::endl;}
+	potentialDCs[pdc] |= dcInfo;
 }
 /// Records time, source premises of exposure, route (local vs shipping), and whether or not
 /// exposure was prevented.
@@ -315,8 +300,8 @@ bool Prem_status::is_exposureSource(Farm* f)
 }
 
 /// Returns true if premises was not reported at time of addition to waitlist
-bool Prem_status::was_dcWhenWaitlisted(const std::string c_type){
-	return (statusWhenWaitlisted.at(c_type) == "dangerousContact" || statusWhenWaitlisted.at(c_type) == "exposed");
+bool Prem_status::was_dcWhenWaitlisted(const int c_type){
+	return (statusWhenWaitlisted.at(c_type) == statusDC || statusWhenWaitlisted.at(c_type) == statusExposed);
 }
 
 /// Returns the time of infection for a farm
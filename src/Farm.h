@@ -4,12 +4,12 @@
 #include <algorithm>
 #include <iostream>
 #include <cstdlib>
-#include <map> // for distances to neighbors
 #include <string>
 #include <unordered_map>
 #include <utility> // for std::iter_swap in rem_probPreventExposure
 #include <vector>
 #include "Point.h"
+#include "Status_names.h"
 
 class County;
 class State;
@@ -24,7 +24,9 @@ class Farm
 {
 	protected: // allows access from derived class Prem_status
 		int id,	///< Unique integer identifier read from premises file
-			cellID; ///< Integer identifier of grid_cell assigned to this premises during grid creation
+			ordinal, ///< Position of this premises among all premises (0 to N-1), used to index per-premises arrays
+			cellID, ///< Integer identifier of grid_cell assigned to this premises during grid creation
+			cellIndex; ///< Position of this premises in its grid_cell's list of premises when the cell was made
 		double x_coordinate, ///< x-coordinate from projected longitude (same units as local spread kernel)
 			y_coordinate, ///< y-coordinate from projected latitude (same units as local spread kernel)
 			sus, ///< Calculated total susceptibility of this premises
@@ -34,18 +36,18 @@ class Farm
 		State* parent_state;
 		Farm_type* farm_type;
 		std::string fips; ///< County identifier (FIPS code)
-		double neighborRadiusCalculated; ///< If neighbors have been calculated and stored as distancesNeighbors, the radius searched (else 0)
 		std::unordered_map< std::string, int > speciesCounts; ///< Numbers of animals of each type, keyed by types
-		std::multimap<double, Farm*> distancesNeighbors; ///< Stored calculations of distances to neighboring premises
 		double oweight; ///< The origin weight of this farm in relation to all other farms within the same state of the same type.
 		double normalized_oweight; ///< The origin weight of this farm in relation to all other farms within the same state of the same type, normalized so the sum of all farms in state = 1.0.
 		double dweight; ///< The destination weight of this farm in relation to all other farms within the same state of the same type.
 
 	public:
-		Farm(int, double, double, std::string);
+		Farm(int, int, double, double, std::string);
 		~Farm();
 		int get_id() const; // inlined
+		int get_ordinal() const; // inlined
 		int get_cellID() const; // inlined
+		int get_cellIndex() const; // inlined
 		Farm_type* get_farm_type() const; //inlined
 		double get_x() const; // inlined
 		double get_y() const; // inlined
@@ -62,9 +64,7 @@ class Farm
  		int get_size_allSpecies() const;
 		County* get_parent_county() const; //Inlined
  		State* get_parent_state() const; //Inlined
- 		const std::multimap<double, Farm*>* get_distancesNeighbors(); //inlined
- 		double get_neighborRadiusCalculated() const; //inlined
-		void set_cellID(const int cellID);
+		void set_cellID(const int cellID, const int cellIndex);
 		void set_farm_type(Farm_type* in_type);
  		void set_speciesCount(const std::string, int);
  		void set_sus(const double);
@@ -73,8 +73,6 @@ class Farm
  		void set_unnormalized_oweight(const double in_oweight);
  		void set_unnormalized_dweight(const double in_dweight);
 		void set_parent_county(County* in_county);
-		void set_distancesNeighbors(std::multimap<double, Farm*>&);
-		void set_neighborRadiusCalculated(const double);
 
 };
 
@@ -82,10 +80,18 @@ inline int Farm::get_id() const
 {
 	return id;
 }
+inline int Farm::get_ordinal() const
+{
+	return ordinal;
+}
 inline int Farm::get_cellID() const
 {
 	return cellID;
 }
+inline int Farm::get_cellIndex() const
+{
+	return cellIndex;
+}
 inline Farm_type* Farm::get_farm_type() const
 {
   return farm_type;
@@ -127,14 +133,6 @@ inline County* Farm::get_parent_county() const
 {
   return parent_county;
 }
-const inline std::multimap<double, Farm*>* Farm::get_distancesNeighbors()
-{
-	return &distancesNeighbors;
-}
-inline double Farm::get_neighborRadiusCalculated() const
-{
-	return neighborRadiusCalculated;
-}
 
 
 class Farm_type
@@ -160,25 +158,26 @@ inline unsigned int Farm_type::get_index() const
     return index;
 }
 
-/// Derived class inheriting from Farm, containing additional info on replicate-specific statuses
-/// and deleted at the end of each replicate. One object of this type is created for each
-/// premises per simulation when it has any kind of status change (i.e. reporting, exposed,
-/// prophylactic vaccination).
+/// Derived class inheriting from Farm, containing additional info on replicate-specific statuses.
+/// One object of this type is used for each premises per simulation when it has any kind of
+/// status change (i.e. reporting, exposed, prophylactic vaccination). Objects are kept in a
+/// Prem_status_table and reused by later replicates.
 class Prem_status: public Farm
 {
 	private:
-		std::string fileStatus; /// Current file status, one of: notDangerousContact, dangerousContact, reported
-		std::string diseaseStatus; /// Current disease status, one of: exp, inf, imm
-		std::vector<std::string> controlStatuses; ///< Vector of all control-related statuses ever effective for this premises
-		std::unordered_map<std::string, std::string> statusWhenWaitlisted; /// Record of premises status at the time of addition to control waitlist - the reason why control was targeted. Key is control type, value is status.
+		int fileStatus; /// Current file status ID, one of: statusNotDC, statusDC, statusExposed, statusReported (see Status_names)
+		int diseaseStatus; /// Current disease status ID, one of: statusSus, statusExp, statusInf, statusImm
+		std::vector<int> controlStatuses; ///< IDs of all control types ever effective for this premises
+		std::vector<int> statusWhenWaitlisted; /// Record of premises file status at the time of addition to control waitlist - the reason why control was targeted. Indexed by control type ID, -1 if not waitlisted.
 
-		std::unordered_map<std::string, int> start; /// Start times for each status. Assumes unique names among file, disease, and control statuses due to mapping by status name.
-		std::unordered_map<std::string, int> end; /// End times for each status. Assumes unique names among file, disease, and control statuses due to mapping by status name.
+		std::vector<int> start; /// Start times for each status, indexed by status ID (-1 if never started)
+		std::vector<int> end; /// End times for each status, indexed by status ID (-1 if never started)
+		std::vector<int> listEntry; /// Latest entry in Status_manager's list for each status, indexed by status ID (-1 if never listed)
 
 		std::vector<double> probPreventExposure; /// Probability of exposure being prevented, given effective control. One element for each control type currently effective.
 		std::vector<double> probPreventTransmission; /// Probability of transmission being prevented, given effective control. One element for each control type currently effective.
 		std::vector<Farm*> dangerousContacts; /// Farms that are dangerousContacts (set when premises is reported)
-		std::unordered_map<Farm*, std::unordered_map<std::string, bool>> potentialDCs; /// Map keyed by pointer to potentialDC, then by disease status, then bool if potentialDC is that status when this premises is reported
+		std::unordered_map<Farm*, unsigned int> potentialDCs; /// Map keyed by pointer to potentialDC, bit s of value set if potentialDC is a dangerous contact when it has disease status s when this premises is reported
 
 		// These vectors are "aligned" - each element corresponds to the same element in the others. Guessed this was easier and more flexible to search than tuple elements.
 		std::vector<int> expTime;
@@ -197,15 +196,17 @@ class Prem_status: public Farm
 	public:
 		Prem_status(Farm*);
 		~Prem_status();
+		void reset(Farm*); ///< Reinitializes as a new Prem_status of another premises, keeping allocated memory
 
-		void add_controlStatus(const std::string); //inlined
+		void add_controlStatus(const int); //inlined
  		void add_exposureSource(int, Farm*, int, std::string); // confirmed record of source of infection, route, block
 
- 		void set_fileStatus(const std::string); //inlined
- 		void set_diseaseStatus(const std::string); //inlined
- 		void set_start(const std::string, const int); //inlined - set start time for status
- 		void set_end(const std::string, const int); //inlined - set end time for status
- 		void set_statusWhenWaitlisted(const std::string, const std::string);//inlined
+ 		void set_fileStatus(const int); //inlined
+ 		void set_diseaseStatus(const int); //inlined
+ 		void set_start(const int, const int); //inlined - set start time for status
+ 		void set_end(const int, const int); //inlined - set end time for status
+ 		void set_listEntry(const int, const int); //inlined - set latest status list entry for status
+ 		void set_statusWhenWaitlisted(const int, const int);//inlined
 
 		double get_probPreventExposure() const;
  		void add_probPreventExposure(double); // inlined
@@ -220,18 +221,19 @@ class Prem_status: public Farm
  		void unvaccinate(); //Removes effect of vaccination in the herd and sets N_s = N_tot.
  		const std::unordered_map<std::string, int>& get_currentSizeUnvaccinated();
 
- 		std::string get_diseaseStatus() const; //inlined
- 		std::string get_fileStatus() const; //inlined
- 		int get_start(std::string) const;
- 		int get_end(std::string) const;
+ 		int get_diseaseStatus() const; //inlined
+ 		int get_fileStatus() const; //inlined
+ 		int get_start(int) const; //inlined
+ 		int get_end(int) const; //inlined
+ 		int get_listEntry(int) const; //inlined
  		std::vector<Farm*> get_dangerousContacts() const; //inlined
- 		std::vector<std::string> get_controlStatuses() const; //inlined
+ 		const std::vector<int>& get_controlStatuses() const; //inlined
  		bool is_exposureSource(Farm*);
- 		void add_potentialDCInfo(Farm*, const std::unordered_map<std::string, bool>&);//inlined
- 		std::unordered_map<Farm*, std::unordered_map<std::string, bool>>* get_potentialDCs();//inlined
+ 		void add_potentialDCInfo(Farm*, unsigned int);//inlined
+ 		std::unordered_map<Farm*, unsigned int>* get_potentialDCs();//inlined
  		void add_DC(Farm* f); //inlined
- 		bool was_dcWhenWaitlisted(const std::string);
- 		bool is_onWaitlist(const std::string);
+ 		bool was_dcWhenWaitlisted(const int);
+ 		bool is_onWaitlist(const int); //inlined
 
  		bool beenExposed() const; //inlined - not used?
 
@@ -246,44 +248,64 @@ class Prem_status: public Farm
                                              const std::unordered_map<std::string, double>& normInf_map);
 };
 
-inline std::string Prem_status::get_fileStatus() const
+inline int Prem_status::get_fileStatus() const
 {
 	return fileStatus;
 }
-inline std::string Prem_status::get_diseaseStatus() const
+inline int Prem_status::get_diseaseStatus() const
 {
 	return diseaseStatus;
 }
+inline int Prem_status::get_start(int status) const
+{
+	return size_t(status) < start.size() ? start[status] : -1;
+}
+inline int Prem_status::get_end(int status) const
+{
+	return size_t(status) < end.size() ? end[status] : -1;
+}
+inline int Prem_status::get_listEntry(int status) const
+{
+	return size_t(status) < listEntry.size() ? listEntry[status] : -1;
+}
 inline std::vector<Farm*> Prem_status::get_dangerousContacts() const
 {
 	return dangerousContacts;
 }
-inline std::vector<std::string> Prem_status::get_controlStatuses() const
+inline const std::vector<int>& Prem_status::get_controlStatuses() const
 {
 	return controlStatuses;
 }
-inline void Prem_status::set_fileStatus(const std::string status)
+inline void Prem_status::set_fileStatus(const int status)
 {
 	fileStatus = status;
 }
-inline void Prem_status::set_diseaseStatus(const std::string stat)
+inline void Prem_status::set_diseaseStatus(const int stat)
 {
 	diseaseStatus = stat;
 }
-inline void Prem_status::add_controlStatus(const std::string status)
+inline void Prem_status::add_controlStatus(const int c_type)
 {
-	controlStatuses.emplace_back(status);
+	controlStatuses.emplace_back(c_type);
 }
-inline void Prem_status::set_start(const std::string status, const int t)
+inline void Prem_status::set_start(const int status, const int t)
 {
+	if (size_t(status) >= start.size()){start.resize(status+1, -1);}
 	start[status] = t;
 }
-inline void Prem_status::set_end(const std::string status, const int t)
+inline void Prem_status::set_end(const int status, const int t)
 {
+	if (size_t(status) >= end.size()){end.resize(status+1, -1);}
 	end[status] = t;
 }
-inline void Prem_status::set_statusWhenWaitlisted(const std::string c_type, const std::string status)
+inline void Prem_status::set_listEntry(const int status, const int entry)
+{
+	if (size_t(status) >= listEntry.size()){listEntry.resize(status+1, -1);}
+	listEntry[status] = entry;
+}
+inline void Prem_status::set_statusWhenWaitlisted(const int c_type, const int status)
 {
+	if (size_t(c_type) >= statusWhenWaitlisted.size()){statusWhenWaitlisted.resize(c_type+1, -1);}
 	statusWhenWaitlisted[c_type] = status;
 }
 
@@ -298,9 +320,9 @@ inline void Prem_status::add_probPreventTransmission(double eff)
 /// Checks whether or not a premises has been exposed to infection by checking for the presence of an "exp" start time
 inline bool Prem_status::beenExposed() const
 {
-	return start.count("exp")==1;
+	return get_start(statusExp) != -1;
 }
-inline std::unordered_map<Farm*, std::unordered_map<std::string, bool>>* Prem_status::get_potentialDCs()
+inline std::unordered_map<Farm*, unsigned int>* Prem_status::get_potentialDCs()
 {
 	return &potentialDCs;
 }
@@ -308,9 +330,9 @@ inline void Prem_status::add_DC(Farm* f)
 {
 	dangerousContacts.emplace_back(f);
 }
-inline bool Prem_status::is_onWaitlist(const std::string c_type)
+inline bool Prem_status::is_onWaitlist(const int c_type)
 {
-	return statusWhenWaitlisted.count(c_type)>0;
+	return size_t(c_type) < statusWhenWaitlisted.size() && statusWhenWaitlisted[c_type] != -1;
 }
 inline void Prem_status::set_currentSize(const std::string species, int sp_count)
 {
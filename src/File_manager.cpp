@@ -12,14 +12,17 @@ File_manager::~File_manager()
 	delete params.kernel;
 }
 
-/// Returns a string to output to run log file, containing batchDateTime (provided as argument), and contents of pv (config file contents)
-const std::string File_manager::getSettings(std::string& bdt)
+/// Returns a string to output to run log file, containing batchDateTime (provided as argument), contents of pv (config file contents),
+/// and the grid parameters chosen automatically (config 40, see Grid_manager::get_tunedGrid)
+const std::string File_manager::getSettings(std::string& bdt, const std::string& tunedGrid)
 {
 	std::string output = bdt;
 	for (int i=1; i<=75; i++){
 		output += "\t";
 		output += pv[i];
 	}
+	output += "\t";
+	output += tunedGrid;
 	output += "\n";
 	return output;
 }
@@ -71,7 +74,25 @@ void File_manager::readConfig(std::string& cfile)
 		params.printCells = stringToNum<int>(pv[4]);
 		params.printShipments = stringToNum<int>(pv[5]);
 		params.printControl = stringToNum<int>(pv[6]);
-		// pv[7] ... pv[10]
+		// Number of threads for replicates
+		if (pv[7]=="*"){pv[7]="1";}
+		params.nThreads = stringToNum<int>(pv[7]);
+		if (params.nThreads<0){
+			std::cout << "ERROR (config 7): Number of threads must be 0 (all available cores) or a positive number." << std::endl; exitflag=1;}
+		// Random number seed - if not specified, seed from clock and record it in the run log
+		if (pv[8]=="*"){pv[8] = std::to_string(Rng_stream::clock_seed());}
+		if (pv[8].empty() || pv[8].find_first_not_of("0123456789") != std::string::npos || pv[8].size() > 19){
+			std::cout << "ERROR (config 8): Random number seed must be a non-negative integer or *." << std::endl; exitflag=1;
+		} else {
+			params.seed = std::stoull(pv[8]);
+			Rng_stream::master().reseed(params.seed);
+		}
+		// Kernel lookup table error bound - if not specified, kernel is evaluated exactly
+		if (pv[9]=="*"){pv[9]="0";}
+		params.kernelTableError = stringToNum<double>(pv[9]);
+		if (params.kernelTableError<0 || params.kernelTableError>=1){
+			std::cout << "ERROR (config 9): Kernel lookup table error must be 0 (exact kernel) or a relative error between 0 and 1." << std::endl; exitflag=1;}
+		// pv[10]
 		// Premises file
 		if (pv[11]=="*"){
 			std::cout << "ERROR (config 11): No premises file specified." << std::endl; exitflag=1;}
@@ -100,10 +121,10 @@ void File_manager::readConfig(std::string& cfile)
 			std::cout << "Warning (config 15): Verbose option must be 0, 1 or 2. Setting option to off." << std::endl;
 			params.verboseLevel = 0;}
 		verbose = params.verboseLevel;
-		// Pairwise on
-		params.pairwiseOn = stringToNum<int>(pv[16]) ;
-		if (params.pairwiseOn!=0 && params.pairwiseOn!=1){
-			std::cout << "ERROR (config 16): Pairwise algorithm must be 1 (on) or 0 (off)." << std::endl; exitflag=1;}
+		// Local spread method
+		params.localSpreadMethod = stringToNum<int>(pv[16]) ;
+		if (params.localSpreadMethod<0 || params.localSpreadMethod>4){
+			std::cout << "ERROR (config 16): Local spread method must be 0 (gridding), 1 (pairwise), 2 (pairwise in batches), 3 (gridding by cell pairs) or 4 (pairwise by skipping ahead)." << std::endl; exitflag=1;}
 		// Reverse x/y
 		params.reverseXY = stringToNum<int>(pv[17]);
 		if (params.reverseXY!=0 && params.reverseXY!=1){
@@ -129,7 +150,10 @@ void File_manager::readConfig(std::string& cfile)
 				params.seedSourceType.compare("singlePremises") == 0 &&
 				params.seedSourceType.compare("multiplePremises") == 0){
 		std::cout << "ERROR (config 22): Seed source type must be 'fips','singlePremises', or 'multiplePremises'." << std::endl; exitflag=1;}
-		// pv[23] unused
+		// Binary premises file to write (can be used as premises file in later runs)
+		params.premBinaryFile = pv[23];
+		if (params.premBinaryFile != "*" && params.premBinaryFile == params.premFile){
+			std::cout << "ERROR (config 23): Binary premises file must be different from the premises file (config 11)." << std::endl; exitflag=1;}
 		// Susceptibility exponents by species
 		std::vector<double> tempVec1 = stringToNumVec(pv[24]);
 		checkExit = checkPositive(tempVec1, 24); if (checkExit==1){exitflag=1;}
@@ -215,13 +239,21 @@ void File_manager::readConfig(std::string& cfile)
 //        }
 
 		// Grid settings
-		if (pv[36]=="*" && pv[37]=="*" && pv[38]=="*"){std::cout << "ERROR (config 36-38): No grid cell parameters specified." << std::endl; exitflag=1;}
+		// Grid parameters chosen automatically (density-based grid with lowest predicted local spread cost)
+		params.gridAutoTune = 0;
+		if (pv[40]!="*"){params.gridAutoTune = stringToNum<int>(pv[40]);}
+		if (params.gridAutoTune!=0 && params.gridAutoTune!=1){std::cout << "ERROR (config 40): Automatic grid parameters must be 0 (off) or 1 (on)." << std::endl; exitflag=1;}
+		if (params.gridAutoTune==1 && (pv[36]!="*" || pv[37]!="*")){std::cout << "ERROR (config 40): Automatic grid parameters can only be used for grids by density (config 36 and 37 must be *)." << std::endl; exitflag=1;}
+		if (pv[36]=="*" && pv[37]=="*" && pv[38]=="*" && params.gridAutoTune==0){std::cout << "ERROR (config 36-38): No grid cell parameters specified." << std::endl; exitflag=1;}
 		params.cellFile = pv[36];
 		params.uniformSide = stringToNum<double>(pv[37]);
+		if (params.gridAutoTune==0){ // config 38 is ignored (and not checked) if parameters are chosen automatically
 		params.densityParams = stringToIntVec(pv[38]);
 			checkExit = checkPositive(params.densityParams, 38); if (checkExit==1){exitflag=1;}
 			if ((params.densityParams).size()!=2){std::cout << "ERROR (config 38): Two parameters required for grid creation by density." << std::endl; exitflag=1;}
-		//pv[39] ... pv[40]
+		}
+		// Grid cache file (written if missing or built from different inputs, otherwise read instead of building grid)
+		params.gridCacheFile = pv[39];
 
 		// Shipping methods and times
 		if (pv[41]=="*"){std::cout << "ERROR (config 41): No county-level shipment method(s) specified." << std::endl; exitflag=1;}
@@ -304,12 +336,12 @@ void File_manager::readConfig(std::string& cfile)
 
 
 			params.exposed_shipments = false;
-			params.statuses_to_generate_shipments_from = {"inf"};
+			params.statuses_to_generate_shipments_from = {statusInf};
 			std::string exposed_shipment_option = pv[50];
 			if(exposed_shipment_option.compare("1") == 0)
             {
                 params.exposed_shipments = true;
-                params.statuses_to_generate_shipments_from.push_back("exp");
+                params.statuses_to_generate_shipments_from.push_back(statusExp);
             }
         }
 
@@ -447,7 +479,16 @@ if(params.control_on == true){
 			exitflag=1;
 			}
 
-		//pv[68]... pv[70]
+		// Neighbor cache for ring control - memory budget (MB) and precomputing at startup
+		if (pv[68]=="*"){pv[68]="256";}
+		params.neighborCacheMB = stringToNum<double>(pv[68]);
+		if (params.neighborCacheMB<0){
+			std::cout << "ERROR (config 68): Neighbor cache memory budget must be 0 (no cache) or a positive number of MB." << std::endl; exitflag=1;}
+		if (pv[69]=="*"){pv[69]="0";}
+		params.precomputeNeighbors = stringToNum<int>(pv[69]);
+		if (pv[69]!="0" && pv[69]!="1"){
+			std::cout << "ERROR (config 69): Precomputing neighbors for control radii must be 0 (as needed) or 1 (at startup)." << std::endl; exitflag=1;}
+		//pv[70]
 
 		// Reporting lags - index
 		checkExit = checkMeanVar(pv[71],71,"index reporting"); if (checkExit==1){exitflag=1;}
@@ -500,6 +541,7 @@ if(params.control_on == true){
 		// Put control parameters into proper containers
 		for (int ct2 = 0; ct2 < params.controlTypes.size(); ++ct2){
 			std::string c_type = params.controlTypes.at(ct2);
+			params.statusNames.add_controlType(c_type);
 
 			params.controlScales[c_type] = spatialScales.at(ct2);
 			params.constraintFunctions[c_type] = cFuncs.at(ct2);
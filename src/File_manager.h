@@ -4,6 +4,7 @@
 #include <fstream>
 #include "shared_functions.h"
 #include "Local_spread.h"
+#include "Status_names.h"
 // shared_functions includes iostream, sstream, string, vector
 
 extern int verboseLevel;
@@ -36,7 +37,8 @@ struct Parameters
 	int printControl;
 
 	// general parameters
-	std::string premFile; ///< File containing tab-delimited premises data: ID, FIPS, x, y, population
+	std::string premFile; ///< File containing tab-delimited premises data: ID, FIPS, x, y, population (or the same in binary format, see premBinaryFile)
+	std::string premBinaryFile; ///< If not "*", premises are also written to this file in binary columnar format, for use as premFile in later runs
 	std::string fipsFile;
 	std::vector<std::string> species;
 	int timesteps;
@@ -46,7 +48,9 @@ struct Parameters
 	int start_day;
 	int replicates;
 	int verboseLevel;
-	bool pairwiseOn;
+	int nThreads; ///< Number of worker threads used to run replicates (0 = all available cores)
+	unsigned long long seed; ///< Seed for the master random number stream, replicate streams are split from it
+	int localSpreadMethod; ///< 0: gridding (binomial), 1: pairwise, 2: pairwise in batches, 3: gridding by cell pairs, 4: pairwise by skipping ahead
 	bool reverseXY;
 
 	// infection parameters
@@ -72,11 +76,14 @@ struct Parameters
 	int kernelType;
 	std::vector<double> kernelParams;
 	Local_spread* kernel;
+	double kernelTableError; ///< Largest relative error of kernel lookup table values (0 to evaluate the kernel exactly)
 
 	// grid parameters
 	std::string cellFile;
 	std::vector<int> densityParams;
 	int uniformSide;
+	std::string gridCacheFile; ///< Binary file of cells and kernel values, reused by later runs with the same inputs ("*" for none)
+	int gridAutoTune; ///< 1: choose density parameters to minimize predicted local spread cost, 0: use config 38
 
 	// shipment parameters
 	bool shipments_on;
@@ -94,11 +101,12 @@ struct Parameters
 	std::vector<std::string> USAMM_dcov_files;
 	std::vector<std::string> USAMM_supernode_files;
 	bool exposed_shipments;
-	std::vector<std::string> statuses_to_generate_shipments_from; //These are the statuses to be considered when generating shipments.
+	std::vector<int> statuses_to_generate_shipments_from; //These are the statuses (IDs) to be considered when generating shipments.
 
 	// control parameters - maps keyed by controlType name
 	bool control_on;
 	std::vector<std::string> controlTypes;
+	Status_names statusNames; ///< IDs of disease, file and control statuses, and of control types
 	std::unordered_map<std::string, std::string> controlScales;
 	std::unordered_map<std::string, std::string> constraintFunctions;
 	std::unordered_map<std::string, std::vector<double>> constraintFuncParams;
@@ -110,6 +118,8 @@ struct Parameters
 
 	// control rules
 	std::vector<controlRule> controlRules;
+	double neighborCacheMB; ///< Memory budget for lists of premises within control radii (0 to calculate lists every time)
+	bool precomputeNeighbors; ///< If true, lists of premises within control radii are calculated for all premises at startup
 	std::vector<std::string> dcControlTypes;
 
 	// reporting parameters
@@ -141,7 +151,7 @@ class File_manager
 		File_manager();
 		~File_manager();
 		const Parameters* getParams(); // inlined
-		const std::string getSettings(std::string&);
+		const std::string getSettings(std::string&, const std::string&);
 		void readConfig(std::string&);
 };
 
@@ -1,9 +1,12 @@
 #include <iostream>
 #include <vector>
 #include <algorithm> // for std::max_element (susceptibility/infectiousness)
+#include <climits> // UINT_MAX
 
 #include "Grid_cell.h"
 
+const unsigned int removedSlot = UINT_MAX; ///< Marks premises removed from a cell in slotByCellIndex
+
 /// Constructed with cell dimensions and premises within. Calculates and stores maximum
 /// transmission values (for overestimating transmission probabilities).
 Grid_cell::Grid_cell(const int in_id, const double in_x, const double in_y,
@@ -13,12 +16,26 @@ Grid_cell::Grid_cell(const int in_id, const double in_x, const double in_y,
 	x(in_x),
 	y(in_y),
 	s(in_s),
-	farms(in_farms)
+	farms(in_farms),
+	susxKern(nullptr)
 {
 	// Add all farms' susceptibility and infectiousness to respective vectors and find max
 	std::vector <double> allSus;
 	std::vector <double> allInf;
+	farmX.reserve(farms.size());
+	farmY.reserve(farms.size());
+	farmSus.reserve(farms.size());
+	farmIDs.reserve(farms.size());
+	farmCellIndex.reserve(farms.size());
+	slotByCellIndex.reserve(farms.size());
 	for (auto& f:farms){
+		farmCellIndex.emplace_back(slotByCellIndex.size());
+		slotByCellIndex.emplace_back(slotByCellIndex.size());
+		// copy values used in transmission checks into contiguous arrays
+		farmX.emplace_back(f->Farm::get_x());
+		farmY.emplace_back(f->Farm::get_y());
+		farmSus.emplace_back(f->Farm::get_sus());
+		farmIDs.emplace_back(f->Farm::get_id());
 		allSus.emplace_back(f->Farm::get_sus_max()); // add farm's susceptibility to vector
 		allInf.emplace_back(f->Farm::get_inf_max()); // add farm's infectiousness to vector
 		// Could make this optional if control or specific target type turned off
@@ -46,15 +63,34 @@ void Grid_cell::addNeighbor(Grid_cell* in_neighbor)
 	neighbors.emplace_back(in_neighbor);
 }
 
-///> Swaps contents of the empty member map for calculated kernel*susceptibility values
-void Grid_cell::take_KernelValues(std::unordered_map<int, double>& in_kern)
+///> Points this cell to the calculated kernel*susceptibility values (row id of in_kern)
+void Grid_cell::set_susxKernel(const Kernel_matrix* in_kern)
 {
-	susxKern.swap(in_kern);
+	susxKern = in_kern;
 }
 
-void Grid_cell::removeFarmSubset(std::vector<int>& toRemove)
+/// The farm is found by its Farm::cellIndex and replaced by the last farm in all arrays,
+/// so the order of remaining farms changes. Farms already removed are ignored.
+void Grid_cell::removeFarm(const Farm* f)
 {
-	auto newEnd = std::remove_if(farms.begin(),farms.end(),farmIDpresent(toRemove));
-	std::vector<Farm*> newFarms(farms.begin(),newEnd);
-	farms.swap(newFarms);
+	unsigned int index = f->Farm::get_cellIndex();
+	unsigned int slot = slotByCellIndex.at(index);
+	if (slot == removedSlot){return;}
+	unsigned int last = farms.size()-1;
+	if (slot != last){
+		farms[slot] = farms[last];
+		farmX[slot] = farmX[last];
+		farmY[slot] = farmY[last];
+		farmSus[slot] = farmSus[last];
+		farmIDs[slot] = farmIDs[last];
+		farmCellIndex[slot] = farmCellIndex[last];
+		slotByCellIndex[farmCellIndex[slot]] = slot;
+	}
+	farms.pop_back();
+	farmX.pop_back();
+	farmY.pop_back();
+	farmSus.pop_back();
+	farmIDs.pop_back();
+	farmCellIndex.pop_back();
+	slotByCellIndex[index] = removedSlot;
 }
@@ -2,8 +2,9 @@
 #define grid_cell_h
 
 #include "County.h" // to include counties included in each cell
-#include "shared_functions.h" // for isWithin function in struct farmInList
+#include "shared_functions.h"
 #include "Farm.h"
+#include "Kernel_matrix.h"
 #include "State.h"
 
 /// Each Grid_cell has x-y coordinates of lower left corner, max susceptibility/infectiousness,
@@ -19,9 +20,15 @@ class Grid_cell
         double s; /// length of one side of square cell (same units as x,y)
         double maxSus; /// Maximum susceptibility value of all premises in this cell
         double maxInf; /// Maximum infectiousness value of all premises in this cell
-        std::vector<Farm*> farms; /// Maximum susceptibility value of all premises in this cell
+        std::vector<Farm*> farms; /// Premises in this cell (in Grid_checker's copies, only those still susceptible)
+        std::vector<double> farmX; /// x-coordinates of farms, in the same order as farms
+        std::vector<double> farmY; /// y-coordinates of farms, in the same order as farms
+        std::vector<double> farmSus; /// Susceptibility of farms, in the same order as farms
+        std::vector<int> farmIDs; /// IDs of farms, in the same order as farms
+        std::vector<unsigned int> farmCellIndex; /// Farm::cellIndex of farms, in the same order as farms
+        std::vector<unsigned int> slotByCellIndex; /// Current position in farms of each premises, by Farm::cellIndex (removedSlot in Grid_cell.cpp once removed)
         std::vector<Grid_cell*> neighbors; /// All Grid_cells touching this cell, not including self
-        std::unordered_map<int, double> susxKern; /// Map of pre-calculated values for cell-cell maximum susceptibility * distance-based kernel. Map key is int rather than pointer because cells are copied and modified in Grid_checker.
+        const Kernel_matrix* susxKern; /// Pre-calculated values for cell-cell maximum susceptibility * distance-based kernel, owned by Grid_manager. Indexed by cell ID rather than pointer because cells are copied and modified in Grid_checker.
 				std::set<std::string> statesIncluded; /// States (2 letter abbreviation) included in cell
         std::set<std::string> countiesIncluded; /// Counties (identified by FIPS code as string) included in this cell
 
@@ -35,14 +42,18 @@ class Grid_cell
 		~Grid_cell();
 
         void addNeighbor(Grid_cell*);
-        std::vector<Farm*> get_farms() const; //inlined
+        const std::vector<Farm*>& get_farms() const; //inlined
+        const std::vector<double>& get_farmX() const; //inlined
+        const std::vector<double>& get_farmY() const; //inlined
+        const std::vector<double>& get_farmSus() const; //inlined
+        const std::vector<int>& get_farmIDs() const; //inlined
 		int get_id() const; //inlined
         double get_maxInf() const; //inlined
         double get_maxSus() const; //inlined
 		const std::vector<Grid_cell*>* get_neighbors(); //inlined
         double get_num_farms() const; // inlined
         double get_s() const; // inlined
-        const std::unordered_map<int, double>* get_susxKernel(); //inlined
+        const Kernel_matrix* get_susxKernel() const; //inlined
         double get_x() const; // inlined
         double get_y() const; // inlined
         double get_south() const; // inlined
@@ -52,14 +63,26 @@ class Grid_cell
         std::set<std::string> get_counties() const; //inlined
         std::set<std::string> get_states() const; //inlined
         double kernelTo(int) const; //inlined
-        void removeFarmSubset(std::vector<int>&);
-		void take_KernelValues(std::unordered_map<int, double>&);
+        void removeFarm(const Farm*);
+		void set_susxKernel(const Kernel_matrix*);
 
 };
 
-inline std::vector<Farm*> Grid_cell::get_farms() const {
+inline const std::vector<Farm*>& Grid_cell::get_farms() const {
 	return farms;}
 
+inline const std::vector<double>& Grid_cell::get_farmX() const {
+	return farmX;}
+
+inline const std::vector<double>& Grid_cell::get_farmY() const {
+	return farmY;}
+
+inline const std::vector<double>& Grid_cell::get_farmSus() const {
+	return farmSus;}
+
+inline const std::vector<int>& Grid_cell::get_farmIDs() const {
+	return farmIDs;}
+
 inline int Grid_cell::get_id() const {
 	return id;}
 
@@ -102,18 +125,10 @@ inline std::set<std::string> Grid_cell::get_counties() const {
 inline std::set<std::string> Grid_cell::get_states() const {
 		return statesIncluded;}
 
-inline double Grid_cell::kernelTo(int id) const {
-	return susxKern.at(id);}
+inline const Kernel_matrix* Grid_cell::get_susxKernel() const {
+	return susxKern;}
 
-///> Identifies if a Farm* is present in a list of ID numbers
-struct farmIDpresent // used in removeFarmSubset function with Farm*
-{
-	farmIDpresent(const std::vector<int> id_list) : ids(id_list) {} // constructor
-	bool operator() (const Farm* f){ // overload operator function
-		return (isWithin(f->Farm::get_id(),ids));
-	}
-	private:
-		std::vector<int> ids; // member
-};
+inline double Grid_cell::kernelTo(int toID) const {
+	return susxKern->at(id, toID);}
 
 #endif
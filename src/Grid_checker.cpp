@@ -1,13 +1,101 @@
 #include "Grid_checker.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits> // std::numeric_limits
+#include <mutex>
+#include <thread>
+
 #include <Rcpp.h>
+// AVX2 and AVX-512 versions are compiled for x86 with GCC or Clang whatever the build
+// flags, and used if the CPU running the code has the instructions
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define USDOS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	void squaredDistancesScalar(double fx, double fy, const double* x, const double* y,
+		double* out, size_t i, size_t n)
+	{
+		for (; i < n; i++){
+			double dx = fx - x[i];
+			double dy = fy - y[i];
+			out[i] = dx*dx + dy*dy;
+		}
+	}
+
+#ifdef USDOS_X86_DISPATCH
+	__attribute__((target("avx512f")))
+	void squaredDistancesAVX512(double fx, double fy, const double* x, const double* y,
+		double* out, size_t n)
+	{
+		size_t i = 0;
+		__m512d vfx = _mm512_set1_pd(fx);
+		__m512d vfy = _mm512_set1_pd(fy);
+		for (; i+8 <= n; i += 8){
+			__m512d dx = _mm512_sub_pd(vfx, _mm512_loadu_pd(x+i));
+			__m512d dy = _mm512_sub_pd(vfy, _mm512_loadu_pd(y+i));
+			_mm512_storeu_pd(out+i, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+		}
+		squaredDistancesScalar(fx, fy, x, y, out, i, n);
+	}
+
+	__attribute__((target("avx2")))
+	void squaredDistancesAVX2(double fx, double fy, const double* x, const double* y,
+		double* out, size_t n)
+	{
+		size_t i = 0;
+		__m256d vfx = _mm256_set1_pd(fx);
+		__m256d vfy = _mm256_set1_pd(fy);
+		for (; i+4 <= n; i += 4){
+			__m256d dx = _mm256_sub_pd(vfx, _mm256_loadu_pd(x+i));
+			__m256d dy = _mm256_sub_pd(vfy, _mm256_loadu_pd(y+i));
+			_mm256_storeu_pd(out+i, _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+		}
+		squaredDistancesScalar(fx, fy, x, y, out, i, n);
+	}
+
+	/// 2 if the CPU has AVX-512, 1 if it has AVX2, 0 otherwise
+	int x86Level()
+	{
+		if (__builtin_cpu_supports("avx512f")){return 2;}
+		if (__builtin_cpu_supports("avx2")){return 1;}
+		return 0;
+	}
+#endif
+
+	/// Squared distances from (fx, fy) to n points. Uses AVX-512 or AVX2 instructions
+	/// if the CPU has them (checked once), with the same results as the scalar loop (no
+	/// fused multiply-add is used).
+	void squaredDistances(double fx, double fy, const double* x, const double* y,
+		double* out, size_t n)
+	{
+#ifdef USDOS_X86_DISPATCH
+		static const int level = x86Level();
+		if (level == 2){
+			squaredDistancesAVX512(fx, fy, x, y, out, n);
+			return;
+		} else if (level == 1){
+			squaredDistancesAVX2(fx, fy, x, y, out, n);
+			return;
+		}
+#endif
+		squaredDistancesScalar(fx, fy, x, y, out, 0, n);
+	}
+}
 
 /// Makes shallow copy of Grid_cells to start as susceptible. Only the vector of pointers
 /// to Farms is modified, not the Farms themselves (hence the shallow copy). Statuses are
 /// only actually changed in Status_manager.
+/// \param[in] in_nThreads Number of threads used to evaluate focal farms (1 if console
+/// output is detailed, so messages stay in order)
 Grid_checker::Grid_checker(const std::unordered_map<int, Grid_cell*>* in_allCells,
 	Status_manager* in_sm,
-	const Parameters* p_in)
+	const Parameters* p_in,
+	unsigned int in_nThreads)
 	:
 	p(p_in),
 	allCells(in_allCells),
@@ -17,10 +105,14 @@ Grid_checker::Grid_checker(const std::unordered_map<int, Grid_cell*>* in_allCell
 	kernel(p->kernel),
     partial(p->partial),
     partialParams(p->partialParams),
-    latencyParams(p->latencyParams)
+    latencyParams(p->latencyParams),
+    localSpreadMethod(p->localSpreadMethod),
+    nThreads(in_nThreads)
 
 {
 	verbose = verboseLevel;//verboseLevel;
+	if (nThreads == 0 || verbose>1){nThreads = 1;}
+	workers.resize(nThreads);
 	int fcount = 0;
 	// initially copy all cells (containing all farms) into susceptible
 	susceptible.reserve(allCells->size());
@@ -29,6 +121,17 @@ Grid_checker::Grid_checker(const std::unordered_map<int, Grid_cell*>* in_allCell
 		fcount += c.second->get_num_farms();
 	}
 	std::sort(susceptible.begin(),susceptible.end(),sortByID<Grid_cell*>);
+	allCopies = susceptible;
+	susceptibleByID.assign(allCells->size(), nullptr);
+	susceptiblePosition.assign(allCells->size(), 0);
+	for (size_t i = 0; i < susceptible.size(); i++){
+		susceptibleByID.at(susceptible[i]->get_id()) = susceptible[i];
+		susceptiblePosition.at(susceptible[i]->get_id()) = i;
+	}
+	for (auto& r:(p->dcRiskScale)){
+		dcRisk.emplace_back(p->statusNames.id(r.first), r.second);
+	}
+	std::sort(dcRisk.begin(), dcRisk.end());
 
 if (verbose>1){std::cout<<"Grid checker constructed. "<<fcount<<" initially susceptible farms in "
 	<<susceptible.size()<<" cells."<<std::endl;}
@@ -36,207 +139,454 @@ if (verbose>1){std::cout<<"Grid checker constructed. "<<fcount<<" initially susc
 
 Grid_checker::~Grid_checker()
 {
-	for (auto& s:susceptible){delete s;}
+	for (auto& s:allCopies){delete s;}
 }
 
 /// Updates static list of cells with susceptible premises within. After transmission
-/// evaluation, records sources of exposure in "sources" map from Status_manager and
-/// records exposures in "exposed" vector, later accessed by Status_manager
+/// evaluation, passes every exposure to Status_manager (add_premForEval), where each is
+/// checked against control and recorded as a source of infection.
+/// Focal farms are evaluated in parallel: threads take the next unevaluated chunk of
+/// focal farms in turn, and keep results in their own Spread_worker. Each chunk draws from
+/// its own random number stream, split by chunk number from a seed drawn from the
+/// replicate's stream. Chunks have a fixed size, and results are passed to Status_manager
+/// in focal farm order, so results are the same for any number of threads. If gridding by
+/// cell pairs (config 16), the same is done with cells containing focal farms in place of
+/// focal farms.
 /// \param[in] focalFarms	All currently infectious premises
-/// \param[in] nonSus		All currently non-susceptible premises that cannot become exposed, including focalFarms
-void Grid_checker::stepThroughCells(std::vector<Farm*>& focalFarms,
+/// \param[in] nonSus		Premises that have become non-susceptible since the last call, including new focalFarms
+void Grid_checker::stepThroughCells(const Prem_view& focalFarms,
 	std::vector<Farm*>& nonSus, int t)
 {
 //================================= update (vector of) susceptible Grid_cells*
-	if (nonSus.size()>0){
-if (verbose>1){std::cout<<"Removing "<<nonSus.size()<<" non-susceptible farms by ID."<<std::endl;}
-		std::unordered_map<int, std::vector<int>> nonSusCellMap;
-		for (auto& ns:nonSus){ // ns is Farm*
-			nonSusCellMap[ns->Farm::get_cellID()].emplace_back(ns->Farm::get_id());
-		}
-		std::vector<Grid_cell*> empties;
-		for (auto& s:susceptible){
-			int sID = s->get_id(); // cell id
-			if (nonSusCellMap.count(sID)==1){ // if this cell is represented in nonSus
-if (verbose>1){std::cout<<"Removing matches in cell "<<sID<<std::endl;}
-				s->removeFarmSubset(nonSusCellMap.at(sID)); // remove those farms from sus cell
-				if (s->get_num_farms()==0){empties.emplace_back(s);}
+	if (nonSus.size()>0){removeNonSusceptible(nonSus);}
+
+//================================= loop through pairs of inf farms and sus Grid_cells
+	Rng_stream stepStream(Rng_stream::current().draw_seed());
+	// tasks are focal farms, or cells with focal farms if gridding by cell pairs
+	bool byCell = (localSpreadMethod == 3);
+	if (byCell){groupByCell(focalFarms);}
+	size_t nTasks = byCell ? focalCellStart.size()-1 : focalFarms.size();
+	focalResults.resize(nTasks);
+	for (auto& w:workers){
+		w.exposures.clear();
+		w.dangerousContacts.clear();
+	}
+	// a new stream for each focal farm would cost more than evaluating most focal farms,
+	// so streams are split per chunk (fixed size, not per thread)
+	const size_t tasksPerChunk = 16;
+	size_t nChunks = (nTasks + tasksPerChunk - 1)/tasksPerChunk;
+	std::atomic<size_t> nextChunk(0);
+	std::exception_ptr workerError;
+	std::mutex errorMutex;
+	auto evalTasks = [&](unsigned int whichWorker){
+		Spread_worker& w = workers[whichWorker];
+		try {
+			for (size_t chunk = nextChunk++; chunk < nChunks; chunk = nextChunk++){
+				Rng_stream chunkStream = stepStream.split(chunk);
+				Rng_binding bindStream(&chunkStream);
+				size_t chunkEnd = std::min(nTasks, (chunk+1)*tasksPerChunk);
+				for (size_t i = chunk*tasksPerChunk; i < chunkEnd; i++){
+					Focal_results& r = focalResults[i];
+					r.worker = whichWorker;
+					r.exposuresBegin = w.exposures.size();
+					r.dcBegin = w.dangerousContacts.size();
+					if (byCell){
+						evalFocalCell(focalByCell.data() + focalCellStart[i], focalCellStart[i+1] - focalCellStart[i], t, w);
+					} else {
+						evalFocalFarm(focalFarms[i], t, w);
+					}
+					r.exposuresEnd = w.exposures.size();
+					r.dcEnd = w.dangerousContacts.size();
+				}
 			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!workerError){workerError = std::current_exception();}
+			nextChunk = nChunks;
 		}
-		// remove any cells that have no (susceptible) farms left
-		if (empties.size()>0){
-			auto newSEnd = std::remove_if(susceptible.begin(),susceptible.end(),isInList<Grid_cell*>(empties));
-if (verbose>1){
-	int cCount = std::distance(newSEnd,susceptible.end());
-	std::cout<<"Removing "<<cCount<<" cell(s) no longer susceptible."<<std::endl;
-}
-			susceptible.erase(newSEnd, susceptible.end());
-		}
-if (verbose>1){
-	int scount = 0;
-	for (auto& s:susceptible){scount += s->get_num_farms();}
-	std::cout<<"Grid_checker:: Susceptible cells updated, now contain "<<scount<<" farms."<<std::endl;}
+	};
+	// no more threads than chunks
+	unsigned int nRun = std::min<size_t>(nThreads, nChunks);
+	if (nRun <= 1){
+		evalTasks(0);
+	} else {
+		std::vector<std::thread> threads;
+		for (unsigned int i = 1; i < nRun; i++){threads.emplace_back(evalTasks, i);}
+		evalTasks(0);
+		for (auto& th:threads){th.join();}
+	}
+	if (workerError){std::rethrow_exception(workerError);}
 
- 	}
+//================================= record results in focal farm (or cell) order
+	for (auto& r:focalResults){
+		Spread_worker& w = workers[r.worker];
+		for (size_t d = r.dcBegin; d < r.dcEnd; d++){
+			Local_DC& dc = w.dangerousContacts[d];
+			statusManagerPointer -> Status_manager::add_potentialDC(dc.source, dc.contact, dc.dcEvaluations);
+		}
+		for (size_t e = r.exposuresBegin; e < r.exposuresEnd; e++){
+			Local_exposure& exp1 = w.exposures[e];
+			statusManagerPointer -> Status_manager::add_premForEval(exp1.exposed, exp1.source, 0, exp1.trueP);
+		}
+	}
+}
 
-//================================= loop through pairs of inf farms and sus Grid_cells
-	  // for each focal farm
-	  for (auto& f1:focalFarms){
-	  	int fcID = f1->Farm::get_cellID();
-	  	Grid_cell* fc = allCells->at(fcID);
-if (verbose>2){std::cout<<"Focal farm "<<f1->Farm::get_id()<<" in cell "<<fcID<<std::endl;}
+/// Steps through whichever is shorter: cells reachable from the focal cell, or remaining
+/// susceptible cells (which are no longer in ID order once cells are removed)
+/// \param[in]	fcID	ID of focal cell
+/// \param[in,out] w Worker in which to list cells (in w.targets)
+void Grid_checker::targetCells(int fcID, Spread_worker& w)
+{
+	const Kernel_matrix* susxKern = allCopies[fcID]->get_susxKernel();
+	w.targets.clear();
+	if (susxKern->get_n_reachable(fcID) <= susceptible.size()){
+		for (const int* cc = susxKern->reachable_begin(fcID); cc != susxKern->reachable_end(fcID); ++cc){
+			Grid_cell* c2 = susceptibleByID[*cc];
+			if (c2 != nullptr){
+if (verbose>2){std::cout<<"Checking in-range comparison cell "<<*cc<<std::endl;}
+				w.targets.emplace_back(c2, susxKern->at(fcID, *cc));
+			}
+		}
+	} else {
 		for (auto& c2:susceptible){
 			int ccID = c2->Grid_cell::get_id();
-			if (fc->kernelTo(ccID)>0){ // check if cell-cell tx possible
+			double kern = susxKern->at(fcID, ccID);
+			if (kern>0){ // check if cell-cell tx possible
 if (verbose>2){std::cout<<"Checking in-range comparison cell "<<ccID<<std::endl;}
-			// Evaluation via gridding
-			std::vector<Farm*> fToCellExp; // farms exposed by f1
-			std::vector<double> trueProbs; // the true probability of transmission of each respective farm in fToCellExp
-			binomialEval(f1,fc,c2,ccID,t,partialParams,fToCellExp, trueProbs);
-			// record sources of infection
-			for (size_t exp_farm_idx=0; exp_farm_idx<fToCellExp.size(); ++exp_farm_idx){
-                auto& exp1=fToCellExp.at(exp_farm_idx);
-                double trueP=trueProbs.at(exp_farm_idx);
-				statusManagerPointer -> Status_manager::add_premForEval(exp1, f1, 0, trueP);
-			}
-			// add to "grand total" exposed list from other farm-cell comparisons if not already present
-			for (auto& exp2:fToCellExp){
-				if (!isWithin<Farm*>(exp2,exposed)){
-					exposed.emplace_back(exp2);
-				}
+				w.targets.emplace_back(c2, kern);
 			}
-
-			} // end if fc can infect cc
 		} // end for loop through comparison cells
-	  } // end for each focal farm
+	}
+}
 
+/// \param[in]	f1	Infectious farm from which to evaluate transmission
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::evalFocalFarm(Farm* f1, int t, Spread_worker& w)
+{
+	int fcID = f1->Farm::get_cellID();
+if (verbose>2){std::cout<<"Focal farm "<<f1->Farm::get_id()<<" in cell "<<fcID<<std::endl;}
+	targetCells(fcID, w);
+	if (localSpreadMethod == 0){
+		binomialTargets(f1, t, w);
+		return;
+	}
+	for (auto& target:w.targets){
+		evalFarmToCell(f1, target.first, target.second, t, w);
+	}
 }
 
-///	Calculates pmax of cell and N, draws h successes from binomial distribution
-///	Randomly selects h farms, evaluates adjusted probabilities
+/// Draws the number of hypothetically exposed premises in every target cell (w.targets)
+/// at once, then evaluates only the cells with any
 /// \param[in]	f1	Infectious farm from which to evaluate transmission
-///	\param[in]	fc	Focal cell containing infectious premises
-///	\param[in]	c2	Comparison cell containing susceptible premises (can be same as fc)
-///	\param[in]	ccID	ID of comparison cell
 /// \param[in]  t  Timestep
-/// \param[in]  partialParams  Parameters for the partial transmission function
-///	\param[out] output  Vector of Farm*s exposed by this infectious farm
-/// \param[out] outputP Vector of true probabilities of infection for each respective farm in the output vector.
-void Grid_checker::binomialEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccID,
-                                int t, std::vector<double> partialParams,
-                                std::vector<Farm*>& output, std::vector<double>& outputP)
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::binomialTargets(Farm* f1, int t, Spread_worker& w)
 {
+	double focalInfMax = f1->Farm::get_inf_max();
+	size_t nTargets = w.targets.size();
+	w.targetN.resize(nTargets);
+	w.targetPmax.resize(nTargets);
+	w.targetExp.resize(nTargets);
+	for (size_t i = 0; i < nTargets; i++){
+		w.targetN[i] = w.targets[i].first->Grid_cell::get_num_farms();
+		// kern: if dangerousContacts_on, this includes DC prob
+		w.targetPmax[i] = oneMinusExp(-focalInfMax * w.targets[i].second);
+	}
+	draw_binom(w.targetN.data(), w.targetPmax.data(), w.targetExp.data(), nTargets);
+	for (size_t i = 0; i < nTargets; i++){
+		if (w.targetExp[i] == 0){continue;} // no infected (or DC) premises in this cell
+		binomialEval(f1, w.targets[i].first, w.targetPmax[i], w.targetExp[i], t, w,
+			w.fToCellExp, w.trueProbs);
+		recordExposures(f1, w);
+	}
+}
 
+/// Sorts focal farms into focalByCell, grouped by cell in order of cell ID, and keeping
+/// their order within each cell
+/// \param[in]	focalFarms	All currently infectious premises
+void Grid_checker::groupByCell(const Prem_view& focalFarms)
+{
+	focalByCell.assign(focalFarms.begin(), focalFarms.end());
+	std::stable_sort(focalByCell.begin(), focalByCell.end(), [](const Farm* a, const Farm* b){
+		return a->Farm::get_cellID() < b->Farm::get_cellID();});
+	focalCellStart.clear();
+	for (size_t i = 0; i < focalByCell.size(); i++){
+		if (i == 0 || focalByCell[i]->Farm::get_cellID() != focalByCell[i-1]->Farm::get_cellID()){
+			focalCellStart.emplace_back(i);
+		}
+	}
+	focalCellStart.emplace_back(focalByCell.size());
+}
 
-    double focalInfMax = f1->Farm::get_inf_max(); // the maximum infectiousness of a farm
+/// Infectiousness is bounded for the cell as a whole, by the largest maximum infectiousness
+/// of its focal farms, so each comparison cell is checked once rather than once per focal
+/// farm.
+/// \param[in]	cellFocal	First of the focal farms in the cell
+/// \param[in]	nFocal	Number of focal farms in the cell
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::evalFocalCell(Farm* const* cellFocal, size_t nFocal, int t, Spread_worker& w)
+{
+	int fcID = cellFocal[0]->Farm::get_cellID();
+if (verbose>2){std::cout<<nFocal<<" focal farm(s) in cell "<<fcID<<std::endl;}
+	w.cellInf.resize(nFocal);
+	w.cellCheckDCs.resize(nFocal);
+	double focalInfMax = 0;
+	for (size_t i = 0; i < nFocal; i++){
+		w.cellInf[i] = focalInfectiousness(cellFocal[i], t);
+		w.cellCheckDCs[i] = dangerousContactsPossible(cellFocal[i]);
+		focalInfMax = std::max(focalInfMax, cellFocal[i]->Farm::get_inf_max());
+	}
+	targetCells(fcID, w);
+	for (auto& target:w.targets){
+		cellPairEval(cellFocal, nFocal, focalInfMax, target.first, target.second, w);
+	}
+}
 
+///	Same method as binomialEval, applied to all (focal farm, comparison farm) pairs between
+/// two cells at once: draws the number of hypothetically exposed pairs from a binomial
+/// with the cell pair's pmax, chooses that many pairs, then keeps each with probability
+/// ptrue/pmax. Each pair is exposed with its own true probability, as with binomialEval,
+/// and each exposure is attributed to the focal farm of its pair. Infectiousness and
+/// whether to check dangerous contacts are read from w.cellInf and w.cellCheckDCs.
+/// \param[in]	cellFocal	First of the focal farms in the cell
+/// \param[in]	nFocal	Number of focal farms in the cell
+/// \param[in]	focalInfMax	Largest maximum infectiousness among the focal farms
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::cellPairEval(Farm* const* cellFocal, size_t nFocal, double focalInfMax,
+	Grid_cell* c2, double kern, Spread_worker& w)
+{
+	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimated probability for any single pair
+	size_t N = c2->Grid_cell::get_num_farms();
+	size_t numExp = 0;
+	if (nFocal*N <= size_t(std::numeric_limits<int>::max())){
+		numExp = draw_binom(int(nFocal*N), pmax);
+	} else { // too many pairs for one draw, so draw for each focal farm (same distribution)
+		for (size_t i = 0; i < nFocal; i++){numExp += draw_binom(int(N), pmax);}
+	}
+	if (numExp == 0){return;}
+
+	const std::vector<Farm*>& compFarms = c2->get_farms();
+	const std::vector<double>& compX = c2->get_farmX();
+	const std::vector<double>& compY = c2->get_farmY();
+	const std::vector<double>& compSusAll = c2->get_farmSus();
+	sample_positions(nFocal*N, numExp, w.pairs, w.pairSet);
+if(verbose>2){std::cout<<"Pmax: "<<pmax<<", "<<numExp<<" hypothetical infections out of "
+	<<nFocal*N<<" farm pairs."<<std::endl;}
+	for (auto& pair:w.pairs){
+		size_t i = pair / N; // focal farm
+		size_t slot = pair % N; // comparison farm
+		Farm* f1 = cellFocal[i];
+		double xdiff = (f1->Farm::get_x() - compX[slot]);
+		double ydiff = (f1->Farm::get_y() - compY[slot]);
+		double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
+		double kernelBWfarms = kernel->atDistSq(distBWfarmssq);
+		double ptrue = oneMinusExp(-w.cellInf[i] * compSusAll[slot] * kernelBWfarms); // prob tx between this farm pair
+		double random = uniform_rand();
+		if (random <= ptrue/pmax){ // actual infection
+if (verbose>1){std::cout << "Infection @ distance: "<< std::sqrt(distBWfarmssq)/1000 << " km, prob "<<ptrue<<std::endl;}
+			w.exposures.push_back({compFarms[slot], f1, ptrue});
+		}
+		if (w.cellCheckDCs[i]){evalDangerousContact(f1, compFarms[slot], ptrue, pmax, w);}
+	}
+}
+
+/// Each farm is removed from its cell by position, and a cell with no susceptible farms
+/// left is replaced in susceptible by the last cell, so the cost depends only on the
+/// number of farms removed.
+/// \param[in] nonSus	Farms that have become non-susceptible since the last update
+void Grid_checker::removeNonSusceptible(const std::vector<Farm*>& nonSus)
+{
+if (verbose>1){std::cout<<"Removing "<<nonSus.size()<<" non-susceptible farms by position in cell."<<std::endl;}
+	int cCount = 0;
+	for (auto& ns:nonSus){ // ns is Farm*
+		int sID = ns->Farm::get_cellID();
+		Grid_cell* s = susceptibleByID[sID];
+		if (s == nullptr){continue;} // cell already has no susceptible farms
+		s->removeFarm(ns);
+		if (s->get_num_farms()==0){
+			// remove cell from susceptible by moving the last cell into its place
+			size_t pos = susceptiblePosition[sID];
+			Grid_cell* last = susceptible.back();
+			susceptible[pos] = last;
+			susceptiblePosition[last->get_id()] = pos;
+			susceptible.pop_back();
+			susceptibleByID[sID] = nullptr;
+			++cCount;
+		}
+	}
+if (verbose>1){
+	std::cout<<"Removed "<<cCount<<" cell(s) no longer susceptible."<<std::endl;
+	int scount = 0;
+	for (auto& s:susceptible){scount += s->get_num_farms();}
+	std::cout<<"Grid_checker:: Susceptible cells updated, now contain "<<scount<<" farms."<<std::endl;}
+}
+
+/// Evaluates transmission from one infectious farm to the susceptible farms of one
+/// comparison cell, and records resulting exposures in w
+/// \param[in]	f1	Infectious farm from which to evaluate transmission
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::evalFarmToCell(Farm* f1, Grid_cell* c2, double kern, int t,
+	Spread_worker& w)
+{
+	std::vector<Farm*>& fToCellExp = w.fToCellExp; // farms exposed by f1
+	std::vector<double>& trueProbs = w.trueProbs; // the true probability of transmission of each respective farm in fToCellExp
+	switch (localSpreadMethod)
+	{
+		case 1:{ // pairwise, one premises at a time
+			pairwise(f1,c2,kern,t,w,fToCellExp,trueProbs);
+			break;
+		}
+		case 2:{ // pairwise, whole cell in batches
+			pairwiseBatch(f1,c2,kern,t,w,fToCellExp,trueProbs);
+			break;
+		}
+		case 4:{ // pairwise, skipping premises that fail the pmax filter
+			pairwiseSkip(f1,c2,kern,t,w,fToCellExp,trueProbs);
+			break;
+		}
+		default:{ // Evaluation via gridding (for all target cells at once, see binomialTargets)
+			double pmax = oneMinusExp(-f1->Farm::get_inf_max() * kern);
+			int numExp = draw_binom(c2->Grid_cell::get_num_farms(), pmax);
+			fToCellExp.clear();
+			trueProbs.clear();
+			if (numExp > 0){binomialEval(f1,c2,pmax,numExp,t,w,fToCellExp,trueProbs);}
+		}
+	}
+	recordExposures(f1, w);
+}
+
+/// Records sources of infection of the farms in w.fToCellExp
+void Grid_checker::recordExposures(Farm* f1, Spread_worker& w)
+{
+	for (size_t exp_farm_idx=0; exp_farm_idx<w.fToCellExp.size(); ++exp_farm_idx){
+		w.exposures.push_back({w.fToCellExp[exp_farm_idx], f1, w.trueProbs[exp_farm_idx]});
+	}
+}
+
+/// Uses the current infectiousness of the farm, or if partial transitions are on
+/// (config 33), the infectiousness it would have if it were unvaccinated
+/// \param[in]	f1	Infectious farm
+/// \param[in]  t  Timestep
+double Grid_checker::focalInfectiousness(Farm* f1, int t)
+{
     double focalInf; //current infectious of a farm
     //if the flag is 0 then use get_inf() to get the total infectiousness of farm
     if(partial==0){
         focalInf = f1->Farm::get_inf();
     }else if(partial!=0){     //if the flag is 1 then use get_inf_partial_as_unvaccinated() to get the total infectiousness of farm as if it were unvaccinated
-        int fid = f1->Farm::get_id();
-        Prem_status* f1_pst = statusManagerPointer->get_correspondingPremStatus(fid); // creates pointer to prem_status object
+        Prem_status* f1_pst = statusManagerPointer->get_correspondingPremStatus(f1); // creates pointer to prem_status object
         focalInf = f1_pst->get_inf_partial_as_unvaccinated(t, p, statusManagerPointer->get_normInf_map()); //the current infectiouness of a farm
     }else{
         std::cout<<"ERROR: In Grid_checker:: Partial tranisition flag does not exist. Exiting...";
         Rcpp::stop("");
     }
+    return focalInf;
+}
+
+/// Dangerous contacts are only evaluated if they are on, and if f1 is not yet reported
+/// (any DCs post-reporting are never used)
+bool Grid_checker::dangerousContactsPossible(Farm* f1)
+{
+	if (p->dangerousContacts_on!=1){return false;}
+	return statusManagerPointer -> Status_manager::getAny_fileStatus(f1) != statusReported;
+}
 
+/// Evaluates whether a candidate premises (hypothetically exposed with probability pmax)
+/// is a dangerous contact of f1 for each reporting status, and stores any with
+/// w (passed to Status_manager after all focal farms are evaluated)
+/// \param[in]	f1	Infectious farm
+/// \param[in]	f2	Candidate premises
+/// \param[in]	ptrue	True probability of transmission from f1 to f2
+/// \param[in]	pmax	Probability with which f2 was chosen as a candidate
+/// \param[in,out] w Worker in which results are recorded
+void Grid_checker::evalDangerousContact(Farm* f1, Farm* f2, double ptrue, double pmax,
+	Spread_worker& w)
+{
+	unsigned int dcEvaluations = 0;
+	for (auto& r:dcRisk){
+		double pDC = ptrue*r.second; // prob of being DC when status is r.first
+		double random = uniform_rand();
+		if (random <= pDC/pmax){
+			dcEvaluations |= 1u << r.first;
+if (verbose>1){std::cout<<"Dangerous contact identified"<<std::endl;}
+		}
+	}
+	if (dcEvaluations != 0){
+		// store DC evaluations with f1
+		w.dangerousContacts.push_back({f1, f2, dcEvaluations});
+	}
+}
 
-	double kern = fc->Grid_cell::kernelTo(ccID); //if dangerousContacts_on, this includes DC prob
-	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimated probability for any single premises
-	double N = c2->Grid_cell::get_num_farms();
-	std::vector<Farm*> fcexp; fcexp.reserve(N); // fcexp = "focal-comparison exposures"
-	std::vector<double> fcexpP; fcexpP.reserve(N); // fcexpK = "focal-comparison exposures kernel value for (true) probabilities"
-
-	// draw number of hypothetical farms exposed, from binomial
-	int numExp = draw_binom(N,pmax);
-
-	if (numExp == 0){ // no infected (or DC, if dangerousContacts_on) premises in this cell
-	} else if (numExp > 0){
-		// randomly choose numExp farms
-		std::vector<Farm*> hypExposed; // hypothetically exposed
-		std::vector<Farm*> compFarms = c2->get_farms();
-		random_unique(compFarms,numExp,hypExposed);
-		// evaluate each of the randomly selected farms
+///	Randomly selects numExp farms (the number of successes drawn from a binomial
+///	distribution with the cell's pmax and N), evaluates adjusted probabilities
+/// \param[in]	f1	Infectious farm from which to evaluate transmission
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be same as focal cell)
+///	\param[in]	pmax	Overestimated probability of transmission to any single premises in c2
+///	\param[in]	numExp	Number of hypothetically exposed premises (more than 0)
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which dangerous contacts are recorded (and arrays are reused)
+///	\param[out] output  Vector of Farm*s exposed by this infectious farm
+/// \param[out] outputP Vector of true probabilities of infection for each respective farm in the output vector.
+void Grid_checker::binomialEval(Farm* f1, Grid_cell* c2, double pmax, int numExp, int t,
+	Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP)
+{
+	output.clear(); // "focal-comparison exposures"
+	outputP.clear(); // true probabilities of focal-comparison exposures
+	double focalInf = focalInfectiousness(f1, t); //current infectious of a farm
+	bool checkDCs = dangerousContactsPossible(f1);
+	// susceptible farms in the comparison cell, stored as contiguous arrays
+	const std::vector<Farm*>& compFarms = c2->get_farms();
+	const std::vector<double>& compX = c2->get_farmX();
+	const std::vector<double>& compY = c2->get_farmY();
+	const std::vector<double>& compSusAll = c2->get_farmSus();
+	// randomly choose numExp farms (by position in cell), without copying the cell
+	std::vector<size_t>& hypExposed = w.chosenSlots; // hypothetically exposed
+	sample_positions(compFarms.size(), numExp, hypExposed, w.permutation);
+	double f1x = f1 -> Farm::get_x();
+	double f1y = f1 -> Farm::get_y();
+	// evaluate each of the randomly selected farms
 if(verbose>2){std::cout<<"Pmax: "<<pmax<<", "<<hypExposed.size()<<" hypothetical infections out of "
 	<<compFarms.size()<<" farms in cell."<<std::endl;}
-		for (auto& f2:hypExposed){
-			// calc actual probabilities
-			double f1x = f1 -> Farm::get_x();
-			double f1y = f1 -> Farm::get_y();
-			double f2x = f2 -> Farm::get_x();
-			double f2y = f2 -> Farm::get_y();
-			double xdiff = (f1x - f2x);
-			double ydiff = (f1y - f2y);
-			double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
-			double kernelBWfarms = kernel->atDistSq(distBWfarmssq); // kernelsq calculates kernel based on distance squared
-			double compSus = f2->Farm::get_sus(); // susceptible farm in comparison cell
-			// calculate probability between these specific farms
-			double ptrue = oneMinusExp(-focalInf * compSus * kernelBWfarms); // prob tx between this farm pair
-			if(verbose>2){std::cout<<"Inf: "<<focalInf<<", sus: "<<compSus<<", kernel: "<<kernelBWfarms<<", Ptrue "<<ptrue<<std::endl;}
-			double random = uniform_rand();
-			if (random <= ptrue/pmax){ // actual infection
+	for (auto& slot:hypExposed){
+		Farm* f2 = compFarms[slot];
+		// calc actual probabilities
+		double xdiff = (f1x - compX[slot]);
+		double ydiff = (f1y - compY[slot]);
+		double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
+		double kernelBWfarms = kernel->atDistSq(distBWfarmssq); // kernelsq calculates kernel based on distance squared
+		double compSus = compSusAll[slot]; // susceptible farm in comparison cell
+		// calculate probability between these specific farms
+		double ptrue = oneMinusExp(-focalInf * compSus * kernelBWfarms); // prob tx between this farm pair
+		if(verbose>2){std::cout<<"Inf: "<<focalInf<<", sus: "<<compSus<<", kernel: "<<kernelBWfarms<<", Ptrue "<<ptrue<<std::endl;}
+		double random = uniform_rand();
+		if (random <= ptrue/pmax){ // actual infection
 if (verbose>1){std::cout << "Infection @ distance: "<< std::sqrt(distBWfarmssq)/1000 << " km, prob "<<ptrue<<std::endl;}
-				fcexp.push_back(f2);
-				fcexpP.push_back(ptrue);
-			}
-			std::string f1Status = statusManagerPointer -> Status_manager::getAny_fileStatus(f1);
-			if (p->dangerousContacts_on==1 && f1Status.compare("reported")!=0){
-			// only bother calculating DCs if f1 is not yet reported, any DCs post-reporting are never used
-				std::unordered_map<std::string, bool> dcEvaluations;
-				bool possibleDC = 0;
-				for (auto& r:(p->dcRiskScale)){
-					double pDC = ptrue*r.second; // prob of being DC when status is r.first
-					double random = uniform_rand();
-					if (random <= pDC/pmax){
-						dcEvaluations[r.first] = 1;
-						possibleDC = 1;
-if (verbose>1){std::cout<<"Dangerous contact identified"<<std::endl;}
-					} else {
-						dcEvaluations[r.first] = 0;
-					}
-				}
-				if (possibleDC){
-					// store DC evaluations with f1
-					if(verbose>1){std::cout<<"GC before call to status manager add_potentialDC"<<std::endl;}
-					statusManagerPointer -> Status_manager::add_potentialDC(f1, f2, dcEvaluations);
-					if(verbose>1){std::cout<<"GC after call to status manager add_potentialDC"<<std::endl;}
-				}
-			}
-
-		 } // end "for each hypothetically exposed farm"
-		} // end "if any hypothetically exposed farms"
-	fcexp.swap(output);
-	fcexpP.swap(outputP);
+			output.push_back(f2);
+			outputP.push_back(ptrue);
+		}
+		if (checkDCs){evalDangerousContact(f1, f2, ptrue, pmax, w);}
+	} // end "for each hypothetically exposed farm"
 }
 
 ///	Calculates and evaluates probability of cell entry, then steps through each premises
 ///	in cell and evaluates adjusted probabilities (Keeling's method)
 /// \param[in]	f1	Infectious farm from which to evaluate transmission
-///	\param[in]	fc	Focal cell containing infectious premises
-///	\param[in]	c2	Comparison cell containing susceptible premises (can be same as fc)
-///	\param[in]	ccID	ID of comparison cell
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
 ///	\param[out]	output	Vector of Farm*s exposed by this infectious premises
-void Grid_checker::countdownEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccID,
+void Grid_checker::countdownEval(Farm* f1, Grid_cell* c2, double kern,
 	std::vector<Farm*>& output, int t,  std::vector<double> partialParams)
 {
     double focalInfMax = f1->Farm::get_inf_max(); // the maximum infectiousness of a farm
 
-    double focalInf; //current infectious of a farm
-    //if the flag is 0 then use get_inf() to get the total infectiousness of farm
-    if(partial==0){
-        focalInf = f1->Farm::get_inf();
-    }else if(partial!=0){     //if the flag is 1 then use get_inf_partial_as_unvaccinated() to get the total infectiousness of farm
-        int fid = f1->Farm::get_id();
-        Prem_status* f1_pst = statusManagerPointer->get_correspondingPremStatus(fid); // creates pointer to prem_status object
-        focalInf = f1_pst->get_inf_partial_as_unvaccinated(t, p, statusManagerPointer->get_normInf_map()); //the current infectiouness of a farm
-    }else{
-        std::cout<<"ERROR: In Grid_checker:: Partial tranisition flag does not exist. Exiting...";
-        Rcpp::stop("");
-    }
-	double kern = fc->Grid_cell::kernelTo(ccID);
+    double focalInf = focalInfectiousness(f1, t); //current infectious of a farm
 	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimated probability for any single premises, "prob6" in MT's Fortran code:
 	double N = c2->Grid_cell::get_num_farms();
 	double pcell = oneMinusExp(-focalInf * kern * N); // Probability of cell entry
@@ -248,8 +598,13 @@ void Grid_checker::countdownEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccI
 // Grid checkpoint A
 	if (random1 <= pcell){ // if farm to cell succeeds
  		int f2count = 1; // how many farms in comparison cell have been checked
- 		std::vector<Farm*> compFarms = c2->get_farms();
-		for (auto& f2:compFarms){
+ 		const std::vector<Farm*>& compFarms = c2->get_farms();
+ 		const std::vector<double>& compX = c2->get_farmX();
+ 		const std::vector<double>& compY = c2->get_farmY();
+ 		const std::vector<double>& compSusAll = c2->get_farmSus();
+		double f1x = f1 -> Farm::get_x();
+		double f1y = f1 -> Farm::get_y();
+		for (size_t slot = 0; slot < compFarms.size(); slot++){
 			double oneMinusExpA = oneMinusExp(-focalInf * kern * (N+1-f2count)); // 1 - exp(A)
 			double pcellAdj = 1 - s + s*oneMinusExpA; // equivalent to 1 - s*exp(A)
 			double random2 = uniform_rand(); // "prob4" in MT's Fortran code
@@ -258,15 +613,11 @@ void Grid_checker::countdownEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccI
 			// if (one max susceptible)/(entrance prob accounting for # of farms checked) succeeds
 			s = 0; // remainingFarmProb recalculates to 1 for remainder of loop
 			// get actual distances between farms
-			double f1x = f1 -> Farm::get_x();
-			double f1y = f1 -> Farm::get_y();
-			double f2x = f2 -> Farm::get_x();
-			double f2y = f2 -> Farm::get_y();
-			double xdiff = (f1x - f2x);
-			double ydiff = (f1y - f2y);
+			double xdiff = (f1x - compX[slot]);
+			double ydiff = (f1y - compY[slot]);
 			double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
 			double kernelBWfarms = kernel->atDistSq(distBWfarmssq); // kernelsq calculates kernel based on distance squared
-			double compSus = f2->Farm::get_sus(); // susceptible farm in comparison cell (farmInf already defined from focal cell)
+			double compSus = compSusAll[slot]; // susceptible farm in comparison cell (farmInf already defined from focal cell)
 
 			// calculate probability between these specific farms
 			// "prob3" in MT's Fortran code
@@ -278,7 +629,7 @@ void Grid_checker::countdownEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccI
 					std::cout << "Infection @ distance: ";
 					std::cout << std::sqrt(distBWfarmssq)/1000 << ", prob "<<ptrue<<std::endl;
 				}
-				fcexp.emplace_back(f2);
+				fcexp.emplace_back(compFarms[slot]);
 			}
 		 } // end "if farm hypothetically exposed"
 		 f2count++;
@@ -290,54 +641,177 @@ void Grid_checker::countdownEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccI
 /// Calculates filtered pairwise transmission: only makes pairwise calculations if random
 /// number passes pmax filter
 /// \param[in]	f1	Infectious farm from which to evaluate transmission
-///	\param[in]	fc	Focal cell containing infectious premises
-///	\param[in]	c2	Comparison cell containing susceptible premises (can be same as fc)
-///	\param[in]	ccID	ID of comparison cell
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which dangerous contacts are recorded (and arrays are reused)
 ///	\param[out]	output	Vector of Farm*s exposed by this infectious premises
-void Grid_checker::pairwise(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccID,
-	std::vector<Farm*>& output, int t,  std::vector<double> partialParams)
+/// \param[out] outputP Vector of true probabilities of infection for each respective farm in the output vector.
+void Grid_checker::pairwise(Farm* f1, Grid_cell* c2, double kern, int t,
+	Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP)
 {
     double focalInfMax = f1->Farm::get_inf_max(); // the maximum infectiousness of a farm
 
-    double focalInf; //current infectious of a farm
-    //if the flag is 0 then use get_inf() to get the total infectiousness of farm
-    if(partial==0){
-        focalInf = f1->Farm::get_inf();
-    }else if(partial!=0){     //if the flag is 1 then use get_inf_partial_as_unvaccinated() to get the total infectiousness of farm
-        int fid = f1->Farm::get_id();
-        Prem_status* f1_pst = statusManagerPointer->get_correspondingPremStatus(fid); // creates pointer to prem_status object
-        focalInf = f1_pst->get_inf_partial_as_unvaccinated(t, p, statusManagerPointer->get_normInf_map()); //the current infectiouness of a farm
-    }else{
-        std::cout<<"ERROR: In Grid_checker:: Partial tranisition flag does not exist. Exiting...";
-        Rcpp::stop("");
-    }
+    double focalInf = focalInfectiousness(f1, t); //current infectious of a farm
 
-	double kern = fc->Grid_cell::kernelTo(ccID);
 	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimate of p for all farms in this cell
-	std::vector<Farm*> cFarms = c2->Grid_cell::get_farms();
+	bool checkDCs = dangerousContactsPossible(f1);
+	const std::vector<Farm*>& cFarms = c2->Grid_cell::get_farms();
+	const std::vector<double>& compX = c2->get_farmX();
+	const std::vector<double>& compY = c2->get_farmY();
+	const std::vector<double>& compSusAll = c2->get_farmSus();
+	double f1x = f1 -> Farm::get_x();
+	double f1y = f1 -> Farm::get_y();
 
-	std::vector<Farm*> fcexp; fcexp.reserve(cFarms.size()); // For output
+	output.clear();
+	outputP.clear();
 
-	for (auto& cf:cFarms){
+	for (size_t slot = 0; slot < cFarms.size(); slot++){
 		double random = uniform_rand();
 		if (random <= pmax){
-			double f1x = f1 -> Farm::get_x();
-			double f1y = f1 -> Farm::get_y();
-			double f2x = cf -> Farm::get_x();
-			double f2y = cf -> Farm::get_y();
-			double xdiff = (f1x - f2x);
-			double ydiff = (f1y - f2y);
+			double xdiff = (f1x - compX[slot]);
+			double ydiff = (f1y - compY[slot]);
 			double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
 			double kernelBWfarms = kernel->atDistSq(distBWfarmssq); // kernelsq calculates kernel based on distance squared
-			double compSus = cf->Farm::get_sus(); // susceptible farm in comparison cell
+			double compSus = compSusAll[slot]; // susceptible farm in comparison cell
 
 			// calculate probability between these specific farms
 			double ptrue = oneMinusExp(-focalInf * compSus * kernelBWfarms); // prob tx between this farm pair
 			if (random <= ptrue){ // actual infection
 if(verbose>1){std::cout << "Infection @ distance: "<< std::sqrt(distBWfarmssq)/1000 << " km, prob "<<ptrue<<std::endl;}
-					fcexp.emplace_back(cf);
+					output.emplace_back(cFarms[slot]);
+					outputP.emplace_back(ptrue);
 			}
+			if (checkDCs){evalDangerousContact(f1, cFarms[slot], ptrue, pmax, w);}
 		}
 	}
-	fcexp.swap(output);
+}
+
+/// Same outcome distribution as pairwise, without a draw for every premises. In pairwise,
+/// each premises passes the pmax filter independently with probability pmax, so the
+/// number of premises skipped before the next one that passes is geometric: it is drawn
+/// from one uniform number, and only premises that pass are evaluated. Given that it
+/// passed, pairwise's draw is uniform on [0, pmax], so a premises is exposed if a new
+/// uniform number is at most ptrue/pmax. The number of draws is proportional to the
+/// expected number of premises passing the filter rather than the number in the cell.
+/// \param[in]	f1	Infectious farm from which to evaluate transmission
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which dangerous contacts are recorded
+///	\param[out]	output	Vector of Farm*s exposed by this infectious premises
+/// \param[out] outputP Vector of true probabilities of infection for each respective farm in the output vector.
+void Grid_checker::pairwiseSkip(Farm* f1, Grid_cell* c2, double kern, int t,
+	Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP)
+{
+	double focalInfMax = f1->Farm::get_inf_max(); // the maximum infectiousness of a farm
+	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimate of p for all farms in this cell
+	output.clear();
+	outputP.clear();
+	if (pmax <= 0){return;}
+	const std::vector<Farm*>& cFarms = c2->Grid_cell::get_farms();
+	const std::vector<double>& compX = c2->get_farmX();
+	const std::vector<double>& compY = c2->get_farmY();
+	const std::vector<double>& compSusAll = c2->get_farmSus();
+	double N = cFarms.size();
+	double logNotPmax = std::log1p(-pmax); // -inf if pmax is 1, so no premises are skipped
+	double focalInf = 0;
+	bool checkDCs = false;
+	bool first = true;
+	double f1x = f1 -> Farm::get_x();
+	double f1y = f1 -> Farm::get_y();
+
+	double slot = 0; // position of the next premises that may pass the filter
+	while (true){
+		// premises skipped before the next to pass the filter, from a uniform number in (0, 1]
+		slot += std::floor(std::log(1 - uniform_rand())/logNotPmax);
+		if (slot >= N){break;}
+		if (first){ // only needed if any premises pass
+			focalInf = focalInfectiousness(f1, t); //current infectious of a farm
+			checkDCs = dangerousContactsPossible(f1);
+			first = false;
+		}
+		size_t s = size_t(slot);
+		double xdiff = (f1x - compX[s]);
+		double ydiff = (f1y - compY[s]);
+		double distBWfarmssq = xdiff*xdiff + ydiff*ydiff;
+		double kernelBWfarms = kernel->atDistSq(distBWfarmssq); // kernelsq calculates kernel based on distance squared
+		// calculate probability between these specific farms
+		double ptrue = oneMinusExp(-focalInf * compSusAll[s] * kernelBWfarms); // prob tx between this farm pair
+		double random = uniform_rand();
+		if (random <= ptrue/pmax){ // actual infection
+if(verbose>1){std::cout << "Infection @ distance: "<< std::sqrt(distBWfarmssq)/1000 << " km, prob "<<ptrue<<std::endl;}
+			output.emplace_back(cFarms[s]);
+			outputP.emplace_back(ptrue);
+		}
+		if (checkDCs){evalDangerousContact(f1, cFarms[s], ptrue, pmax, w);}
+		slot += 1;
+	}
+}
+
+/// Same transmission probabilities and random draws per premises as pairwise, but each
+/// step is done for the whole cell before the next: draw one uniform per premises,
+/// keep candidates that pass the pmax filter, then calculate distances, kernel values
+/// and true probabilities for all candidates at once. The loops run over contiguous
+/// arrays (reused between calls) so they can be vectorized; distances use AVX2 or AVX-512
+/// instructions when the CPU has them, while kernel values are calculated one at a time
+/// (scalar pow, or the lookup table of config 9). If dangerous contacts are
+/// evaluated, their draws come after all of the cell's draws rather than in between.
+/// \param[in]	f1	Infectious farm from which to evaluate transmission
+///	\param[in]	c2	Comparison cell containing susceptible premises (can be the focal cell)
+///	\param[in]	kern	Kernel * maximum susceptibility from the focal cell to c2
+/// \param[in]  t  Timestep
+/// \param[in,out] w Worker in which dangerous contacts are recorded (and arrays are reused)
+///	\param[out]	output	Vector of Farm*s exposed by this infectious premises
+/// \param[out] outputP Vector of true probabilities of infection for each respective farm in the output vector.
+void Grid_checker::pairwiseBatch(Farm* f1, Grid_cell* c2, double kern, int t,
+	Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP)
+{
+	double focalInfMax = f1->Farm::get_inf_max(); // the maximum infectiousness of a farm
+	double focalInf = focalInfectiousness(f1, t); //current infectious of a farm
+	double pmax = oneMinusExp(-focalInfMax * kern); // Overestimate of p for all farms in this cell
+	const std::vector<Farm*>& cFarms = c2->Grid_cell::get_farms();
+	const std::vector<double>& compX = c2->get_farmX();
+	const std::vector<double>& compY = c2->get_farmY();
+	const std::vector<double>& compSusAll = c2->get_farmSus();
+	size_t N = cFarms.size();
+	output.clear();
+	outputP.clear();
+
+	// one draw per premises, keep positions of those passing the pmax filter
+	w.batchRandom.resize(N);
+	uniform_rand(w.batchRandom.data(), N);
+	w.batchSlots.resize(N);
+	size_t nCandidates = 0;
+	for (size_t slot = 0; slot < N; slot++){
+		w.batchSlots[nCandidates] = slot;
+		nCandidates += (w.batchRandom[slot] <= pmax);
+	}
+	if (nCandidates == 0){return;}
+
+	// gather candidate coordinates, then distances and kernel values for all candidates
+	w.batchX.resize(nCandidates);
+	w.batchY.resize(nCandidates);
+	for (size_t c = 0; c < nCandidates; c++){
+		w.batchX[c] = compX[w.batchSlots[c]];
+		w.batchY[c] = compY[w.batchSlots[c]];
+	}
+	w.batchDistSq.resize(nCandidates);
+	squaredDistances(f1->Farm::get_x(), f1->Farm::get_y(), w.batchX.data(), w.batchY.data(),
+		w.batchDistSq.data(), nCandidates);
+	w.batchKernel.resize(nCandidates);
+	kernel->atDistSq(w.batchDistSq.data(), w.batchKernel.data(), nCandidates);
+
+	bool checkDCs = dangerousContactsPossible(f1);
+	for (size_t c = 0; c < nCandidates; c++){
+		size_t slot = w.batchSlots[c];
+		// calculate probability between these specific farms
+		double ptrue = oneMinusExp(-focalInf * compSusAll[slot] * w.batchKernel[c]); // prob tx between this farm pair
+		if (w.batchRandom[slot] <= ptrue){ // actual infection
+if(verbose>1){std::cout << "Infection @ distance: "<< std::sqrt(w.batchDistSq[c])/1000 << " km, prob "<<ptrue<<std::endl;}
+			output.emplace_back(cFarms[slot]);
+			outputP.emplace_back(ptrue);
+		}
+		if (checkDCs){evalDangerousContact(f1, cFarms[slot], ptrue, pmax, w);}
+	}
 }
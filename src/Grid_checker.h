@@ -15,8 +15,10 @@ class Grid_checker
 	private:
 		const Parameters* p;
 		int verbose; ///< Can be set to override global setting for console output
-		std::vector<Grid_cell*> susceptible; ///< Local copy of cells, with vectors of susceptible farms within
-		std::vector<Farm*> exposed; ///< List of farms most recently exposed
+		std::vector<Grid_cell*> susceptible; ///< Local copy of cells that still have susceptible farms, with vectors of susceptible farms within
+		std::vector<Grid_cell*> susceptibleByID; ///< Same cells as susceptible, indexed by cell ID (nullptr once no susceptible farms remain)
+		std::vector<size_t> susceptiblePosition; ///< Position of each cell in susceptible, indexed by cell ID
+		std::vector<Grid_cell*> allCopies; ///< All local copies of cells, in order of cell ID (deleted with the checker)
 		const std::unordered_map<int, Grid_cell*>* allCells; ///< Pointer to Grid_manager cells, referenced in infection evaluation among cells
         // variables for infection evaluation
         std::vector<std::string> speciesOnPrems; ///< List of species on all farms provided in premises file
@@ -26,35 +28,89 @@ class Grid_checker
         int partial;
         std::vector<double> partialParams;
         std::tuple<double, double> latencyParams;
+        std::vector<std::pair<int, double>> dcRisk; ///< Disease status ID and DC risk scale (config 74), in order of ID
+        int localSpreadMethod; ///< 0: gridding (binomial), 1: pairwise, 2: pairwise in batches, 3: gridding by cell pairs, 4: pairwise by skipping ahead (config 16)
+        unsigned int nThreads; ///< Number of threads evaluating focal farms in parallel
 
-		void binomialEval(Farm* f1, Grid_cell* fc, Grid_cell* c2, int ccID, int t, std::vector<double> partialParams, std::vector<Farm*>& output, std::vector<double>& outputP); ///< Evaluates transmission from a focal farm to all susceptible farms in a cell via binomial method
-		void countdownEval(Farm*,Grid_cell*,Grid_cell*,int,std::vector<Farm*>&, int t, std::vector<double>partialParams); ///< Evaluates transmission from a focal farm to all susceptible farms in a cell via Keeling's "countdown" method
-		void pairwise(Farm*,Grid_cell*,Grid_cell*,int,std::vector<Farm*>&, int t , std::vector<double> partialParams); ///< Evaluates transmission from a focal farm to all susceptible farms in a cell pairwise
+        /// A premises exposed by a focal farm, with the true probability of transmission
+        struct Local_exposure
+        {
+            Farm* exposed;
+            Farm* source;
+            double trueP;
+        };
+        /// Dangerous contact evaluations of a candidate premises for a focal farm
+        struct Local_DC
+        {
+            Farm* source;
+            Farm* contact;
+            unsigned int dcEvaluations; ///< Bit s is set if contact is a DC when source is in disease status s
+        };
+        /// Results and reusable arrays of one thread. Results are kept here while focal
+        /// farms are evaluated, and passed to Status_manager afterwards.
+        struct Spread_worker
+        {
+            std::vector<Local_exposure> exposures;
+            std::vector<Local_DC> dangerousContacts;
+            std::vector<Farm*> fToCellExp; ///< Farms exposed by a focal farm in one comparison cell
+            std::vector<double> trueProbs; ///< True probability of transmission for each of fToCellExp
+            // reusable arrays for pairwiseBatch
+            std::vector<double> batchRandom, batchX, batchY, batchDistSq, batchKernel;
+            std::vector<size_t> batchSlots;
+            // reusable arrays for gridding
+            std::vector<int> targetN; ///< Number of susceptible farms in each target cell of a focal farm
+            std::vector<double> targetPmax; ///< Maximum probability of transmission from a focal farm to each target cell
+            std::vector<int> targetExp; ///< Number of hypothetically exposed premises in each target cell
+            std::vector<size_t> chosenSlots; ///< Positions of hypothetically exposed premises in a comparison cell
+            std::vector<size_t> permutation; ///< Scratch space for choosing positions (see sample_positions)
+            // reusable arrays for gridding by cell pairs
+            std::vector<std::pair<Grid_cell*, double>> targets; ///< Susceptible cells in range of a focal cell, with kernel * maximum susceptibility
+            std::vector<double> cellInf; ///< Infectiousness of each infectious farm in a focal cell
+            std::vector<char> cellCheckDCs; ///< Whether dangerous contacts are evaluated for each infectious farm in a focal cell
+            std::vector<size_t> pairs; ///< Positions of hypothetically exposed (focal, comparison) farm pairs
+            Position_set pairSet; ///< Scratch space for choosing pairs (see sample_positions)
+        };
+        /// Which worker evaluated a focal farm (or focal cell), and where its results are in that worker
+        struct Focal_results
+        {
+            unsigned int worker;
+            size_t exposuresBegin, exposuresEnd;
+            size_t dcBegin, dcEnd;
+        };
+        std::vector<Spread_worker> workers; ///< One per thread
+        std::vector<Focal_results> focalResults; ///< One per focal farm (or focal cell) in the current timestep
+        std::vector<Farm*> focalByCell; ///< Focal farms sorted by cell (gridding by cell pairs only)
+        std::vector<size_t> focalCellStart; ///< Start of each focal cell's farms in focalByCell, plus the end
+
+		void removeNonSusceptible(const std::vector<Farm*>& nonSus); ///< Removes farms from the local cell copies, and cells left empty from susceptible
+		void groupByCell(const Prem_view& focalFarms); ///< Fills focalByCell and focalCellStart
+		void targetCells(int fcID, Spread_worker& w); ///< Lists susceptible cells in range of cell fcID in w.targets
+		void evalFocalFarm(Farm* f1, int t, Spread_worker& w); ///< Evaluates transmission from a focal farm to all susceptible cells in range
+		void evalFocalCell(Farm* const* cellFocal, size_t nFocal, int t, Spread_worker& w); ///< Evaluates transmission from all focal farms in a cell to all susceptible cells in range
+		void cellPairEval(Farm* const* cellFocal, size_t nFocal, double focalInfMax, Grid_cell* c2, double kern, Spread_worker& w); ///< Evaluates transmission from focal farms in one cell to all susceptible farms in another via binomial method over farm pairs
+		void evalFarmToCell(Farm* f1, Grid_cell* c2, double kern, int t, Spread_worker& w); ///< Evaluates and records exposures from a focal farm to one comparison cell
+		void recordExposures(Farm* f1, Spread_worker& w); ///< Adds exposures by f1 in one comparison cell to the worker's results
+		void binomialTargets(Farm* f1, int t, Spread_worker& w); ///< Evaluates and records exposures from a focal farm to all target cells via binomial method
+		void binomialEval(Farm* f1, Grid_cell* c2, double pmax, int numExp, int t, Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP); ///< Evaluates numExp hypothetical exposures from a focal farm to susceptible farms in a cell
+		void countdownEval(Farm*,Grid_cell*,double,std::vector<Farm*>&, int t, std::vector<double>partialParams); ///< Evaluates transmission from a focal farm to all susceptible farms in a cell via Keeling's "countdown" method
+		void pairwise(Farm* f1, Grid_cell* c2, double kern, int t, Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP); ///< Evaluates transmission from a focal farm to all susceptible farms in a cell pairwise
+		void pairwiseSkip(Farm* f1, Grid_cell* c2, double kern, int t, Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP); ///< Evaluates transmission pairwise, drawing the gaps between premises that pass the pmax filter
+		void pairwiseBatch(Farm* f1, Grid_cell* c2, double kern, int t, Spread_worker& w, std::vector<Farm*>& output, std::vector<double>& outputP); ///< Evaluates transmission pairwise, with each step done for the whole cell at once
+		double focalInfectiousness(Farm* f1, int t); ///< Infectiousness of a focal farm used in transmission probabilities
+		bool dangerousContactsPossible(Farm* f1); ///< True if dangerous contacts of f1 should be evaluated
+		void evalDangerousContact(Farm* f1, Farm* f2, double ptrue, double pmax, Spread_worker& w); ///< Evaluates whether f2 is a dangerous contact of f1, recorded in w
 
 	public:
 		///< Makes local copy of all Grid_cells, initially set as susceptible to check local spread against
 		Grid_checker(const std::unordered_map<int, Grid_cell*>*,
-			Status_manager*, const Parameters*);
+			Status_manager*, const Parameters*, unsigned int in_nThreads = 1);
 		~Grid_checker();
 
 		///< Function that handles actual comparisons between focal and susceptible premises.
 		void stepThroughCells(
-			std::vector<Farm*>&, // infectious
+			const Prem_view&, // infectious
 			std::vector<Farm*>&,//non-susceptible
             int t);
 };
 
-///> Determines if an object is present in a vector of objects.
-/// Used to remove any Grid_cells that no longer contain any susceptible farms.
-template<typename T>
-struct isInList // used in grid checker for Grid_cell*
-{
-	isInList(const std::vector<T> in_list) : itemList(in_list) {} // constructor
-	bool operator() (const T item){ // overload operator function
-		return (isWithin(item,itemList));
-	}
-	private:
-		std::vector<T> itemList; // member
-};
-
 #endif
@@ -1,6 +1,6 @@
 #include <Rcpp.h>
 
-// included in Grid_manager.h: algorithm, queue, stack, unordered_map, vector
+// included in Grid_manager.h: algorithm, queue, unordered_map, vector
 #include <cmath> // std::sqrt
 #include <fstream>
 #include <iostream>
@@ -8,15 +8,23 @@
 #include <set> // for comparing otherwise unsorted lists of infected farms, pw vs gridding
 #include <sstream>
 #include <string>
+#include <atomic> // std::atomic for handing out blocks of cell pairs to threads
+#include <chrono> // wall-clock timing of multi-threaded steps
+#include <cstdio> // std::rename, std::remove for grid cache
 #include <ctime> // for timing
 #include <exception>
+#include <thread>
 #include <algorithm>
 // included in Grid_manager.h: grid_cell, farm, shared_functions, tuple, utility
 #include "Grid_manager.h"
 #include "State.h"
 #include "County.h"
+#include "Premises_file.h"
 #include "shared_functions.h"
 
+const char gridCacheID[8] = {'U','S','D','O','S','G','R','D'}; ///< Identifies grid cache files
+const unsigned int gridCacheVersion = 2; ///< Increase when the grid cache file layout changes
+
 /// Loads premises from file, calculates summary statistics
 Grid_manager::Grid_manager(const Parameters* p)
 	:
@@ -27,6 +35,7 @@ Grid_manager::Grid_manager(const Parameters* p)
 	susValues(p->susConsts),
 	infValues(p->infConsts),
 	kernel(p->kernel),
+	tunedGrid("*"),
 	committedFarms(0),
 	printCellFile(p->printCells),
 	batch(p->batch),
@@ -51,6 +60,28 @@ Grid_manager::Grid_manager(const Parameters* p)
 	}
     readFips_and_states(); // read centroids, areas, state codes, make states
 
+	// kernel lookup table is asked to cover the longest distance between any two premises,
+	// makeTable trims it to the distance where the kernel becomes negligible
+	double xRange = std::get<1>(xylimits) - std::get<0>(xylimits);
+	double yRange = std::get<3>(xylimits) - std::get<2>(xylimits);
+	kernel->makeTable(xRange*xRange + yRange*yRange, parameters->kernelTableError);
+
+	// buckets for ring control are as wide as the smallest control radius
+	std::vector<double> controlRadii;
+	if (parameters->control_on){
+		for (auto& rule:parameters->controlRules){
+			if (rule.target > 0){controlRadii.emplace_back(rule.target);}
+		}
+	}
+	if (!controlRadii.empty()){
+		premisesIndex.build(farm_vector, *std::min_element(controlRadii.begin(), controlRadii.end()));
+		neighborCache.set_index(&premisesIndex);
+		neighborCache.set_budget(parameters->neighborCacheMB);
+		if (parameters->precomputeNeighbors){
+			neighborCache.precompute(farm_vector, controlRadii, threadsToUse(parameters->nThreads));
+		}
+	}
+
 if (verbose>1){
 	std::cout << "x min = " << std::get<0>(xylimits) << std::endl;
 	std::cout << "x max = " << std::get<1>(xylimits) << std::endl;
@@ -179,135 +210,111 @@ void Grid_manager::readFarms(const std::string& farm_fname)
 		sumQ[s] = 0.0;
 	}
 
-	std::ifstream f(parameters->premFile);
-	if(!f){std::cout << "Premises file not found. Exiting..." << std::endl; Rcpp::stop("");}
-	if(f.is_open())
-	{
-	    skipBOM(f);
-        if (verbose>0){std::cout << "Premises file open, loading premises." << std::endl;}
-
-		while(! f.eof())
+	// read all rows first (on several threads if the file is text), then create premises in file order
+	std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+	Premises_columns prems;
+	Premises_file premReader(speciesOnPrems.size(), threadsToUse(parameters->nThreads));
+	premReader.read(farm_fname, prems);
+	if (parameters->premBinaryFile != "*"){premReader.write(parameters->premBinaryFile, prems);}
+	std::chrono::steady_clock::time_point read_end = std::chrono::steady_clock::now();
+if (verbose>0){std::cout << prems.size() << " premises rows read in " <<
+	std::chrono::duration_cast<std::chrono::milliseconds>(read_end - read_start).count() << "ms." << std::endl;}
+
+	for (size_t row = 0; row < prems.size(); row++){
+		id = prems.id[row];
+		//Convert string to int, and then back again in order to remove any zeros in the beginning.
+		int int_fips = prems.fips[row];
+		if(int_fips == 46113) //Shannon county (46113) changed to Oglala, 46102.
 		{
-			std::string line;
-			getline(f, line); // get line from file "f", save as "line"
-			std::vector<std::string> line_vector = split(line, '\t'); // separate by tabs
+			int_fips = 46102;
+		}
+		fips = std::to_string(int_fips);
+
+		if (parameters->reverseXY){ // file is formatted as: lat, then long (y, then x)
+			y = prems.coord1[row];
+			x = prems.coord2[row];
+		} else { // file is formatted as: long, then lat (x, then y)
+			x = prems.coord1[row];
+			y = prems.coord2[row];
+		}
 
-			if(! line_vector.empty()) // if line_vector has something in it
+		if(prems.totals[row] < 1)
+		{
+			if(verbose>1)
 			{
-				id = stringToNum<int>(line_vector[0]);
-				//Convert string to int, and then back again in order to remove any zeros in the beginning.
-				int int_fips = stringToNum<int>(line_vector[1]);
-				if(int_fips == 46113) //Shannon county (46113) changed to Oglala, 46102.
-                {
-                    int_fips = 46102;
-                }
-				fips = std::to_string(int_fips);
-
-				if (parameters->reverseXY){ // file is formatted as: lat, then long (y, then x)
-					y = stringToNum<double>(line_vector[2]);
-					x = stringToNum<double>(line_vector[3]);
-				} else if (!parameters->reverseXY){ // file is formatted as: long, then lat (x, then y)
-					x = stringToNum<double>(line_vector[2]);
-					y = stringToNum<double>(line_vector[3]);
-				}
-
-				// add species counts - check that number of columns is as expected
-				if (line_vector.size() < 4+speciesOnPrems.size()){
-					std::cout<<"ERROR (premises file & config 44-46) at line"<<std::endl;
-					std::cout<< line <<std::endl;
-					std::cout<< ": number of columns with animal populations don't match up with list of species provided."<<std::endl;
-					std::cout<<"Exiting..."<<std::endl;
-					Rcpp::stop("");
-				}
-
-				unsigned int colcount = 4; // animal populations start at column 4
-				unsigned int total_animals = 0;
-				std::vector<int> animal_numbers;
-				for(size_t i = colcount; i < line_vector.size(); i++)
-                {
-                    unsigned int tempsize = stringToNum<int>(line_vector[i]);
-                    total_animals += tempsize;
-                    animal_numbers.push_back(tempsize);
-                }
-
-                if(total_animals < 1)
-                {
-                    if(verbose>1)
-                    {
-                        std::cout << "Warning: Premises with id " << id << " has no animals of any species. "
-                                  << "Skipping this farm..." << std::endl;
-                    }
-					continue;
-                }
+				std::cout << "Warning: Premises with id " << id << " has no animals of any species. "
+						  << "Skipping this farm..." << std::endl;
+			}
+			continue;
+		}
 
-				// write farm pointer to private var farm_map
-				farm_map[id] = new Farm(id, x, y, fips);
-				farm_vector.push_back(farm_map.at(id));
-				++fcount;
-
-                std::string herd(speciesOnPrems.size(), '0');
-				for (size_t i = 0; i < speciesOnPrems.size(); i++){ // for each species
-					std::string sp = speciesOnPrems[i]; //Name of this species
-					unsigned int number = animal_numbers[i]; //Number of individuals of this species/type
-					farm_map.at(id)->set_speciesCount(sp, number);// set number for species at premises
-					sumSp[sp] += number;
-					// get infectiousness ("p") for this species
-					double p = infExponents.at(sp);
-					sumP[sp] += pow(double(number),p);
-					// get susceptibility ("q") for this species
-					double q = susExponents.at(sp);
-					sumQ[sp] += pow(double(number),q);
-
-					// if there are animals of this species, add to fips-species list to sort by population later
-					if (number > 0){
-						fipsSpeciesMap[fips][sp].emplace_back(farm_map.at(id));
-						herd[i] = '1';
-					}
-				}
+		// write farm pointer to private var farm_map
+		Farm* prem = new Farm(id, farm_vector.size(), x, y, fips);
+		farm_map[id] = prem;
+		farm_vector.push_back(prem);
+		++fcount;
+
+		std::string herd(speciesOnPrems.size(), '0');
+		const int* animal_numbers = &prems.counts[row*prems.nSpecies];
+		for (size_t i = 0; i < speciesOnPrems.size(); i++){ // for each species
+			const std::string& sp = speciesOnPrems[i]; //Name of this species
+			unsigned int number = animal_numbers[i]; //Number of individuals of this species/type
+			prem->set_speciesCount(sp, number);// set number for species at premises
+			sumSp[sp] += number;
+			// get infectiousness ("p") for this species
+			double p = infExponents.at(sp);
+			sumP[sp] += pow(double(number),p);
+			// get susceptibility ("q") for this species
+			double q = susExponents.at(sp);
+			sumQ[sp] += pow(double(number),q);
+
+			// if there are animals of this species, add to fips-species list to sort by population later
+			if (number > 0){
+				fipsSpeciesMap[fips][sp].emplace_back(prem);
+				herd[i] = '1';
+			}
+		}
 
-				//Assign the correct farm type to the farm.
-                Farm_type* farm_type = get_farm_type_by_herd(herd);
-                farm_map.at(id)->set_farm_type(farm_type);
+		//Assign the correct farm type to the farm.
+		Farm_type* farm_type = get_farm_type_by_herd(herd);
+		prem->set_farm_type(farm_type);
 
 // At this point, fixed data pertaining to the farm (coordinates, numbers, types) should
 // be final - farm will be copied into other locations (maps by counties)
 
-				// If county doesn't exist, create it
-				if (FIPS_map.count(fips) == 0){
-                    County* new_county = new County(fips, shipment_kernel_str);
-			    	FIPS_map[fips] = new_county;
-			    	FIPS_vector.emplace_back(new_county);
-                }
+		// If county doesn't exist, create it
+		auto county = FIPS_map.find(fips);
+		if (county == FIPS_map.end()){
+			County* new_county = new County(fips, shipment_kernel_str);
+			county = FIPS_map.emplace(fips, new_county).first;
+			FIPS_vector.emplace_back(new_county);
+		}
 
-				// Add farm to its corresponding county object
-				try{
-					FIPS_map.at(fips)->County::add_farm(farm_map.at(id));
-				}
-				catch(std::exception& e){
-					std::cout << "When adding premises " << id << " to county " << fips << "." <<
-							  e.what() << std::endl;
-					Rcpp::stop("");
- 				}
+		// Add farm to its corresponding county object
+		try{
+			county->second->County::add_farm(prem);
+		}
+		catch(std::exception& e){
+			std::cout << "When adding premises " << id << " to county " << fips << "." <<
+					  e.what() << std::endl;
+			Rcpp::stop("");
+		}
 
 
-				// compare/replace limits of xy plane
-				if (fcount>1){// if this is not the first farm
-					if (x < std::get<0>(xylimits)){std::get<0>(xylimits) = x;} // x min
-					else if (x > std::get<1>(xylimits)){std::get<1>(xylimits) = x;} // x max
+		// compare/replace limits of xy plane
+		if (fcount>1){// if this is not the first farm
+			if (x < std::get<0>(xylimits)){std::get<0>(xylimits) = x;} // x min
+			else if (x > std::get<1>(xylimits)){std::get<1>(xylimits) = x;} // x max
 
-					if (y < std::get<2>(xylimits)){std::get<2>(xylimits) = y;} // y min
-					else if (y > std::get<3>(xylimits)){std::get<3>(xylimits) = y;} // y max
-					}
-				else {
+			if (y < std::get<2>(xylimits)){std::get<2>(xylimits) = y;} // y min
+			else if (y > std::get<3>(xylimits)){std::get<3>(xylimits) = y;} // y max
+			}
+		else {
 if (verbose>1){std::cout << "Initializing xy limits.";}
-					xylimits = std::make_tuple(x,x,y,y);
-					// initialize min & max x value, min & max y value
-                }
-
-			} // close "if line_vector not empty"
-		} // close "while not end of file"
-		f.close();
-	} // close "if file is open"
+			xylimits = std::make_tuple(x,x,y,y);
+			// initialize min & max x value, min & max y value
+		}
+	} // close "for each premises row"
 
     // copy farmlist from farm_map (will be changed as grid is created)
     if (verbose>1){std::cout << "Copying farms from farm_map to farmList..." << std::endl;}
@@ -431,37 +438,6 @@ if(verbose>1){std::cout << "Getting farms in cell..." << std::endl;
     return(inCell);
 }
 
-void Grid_manager::removeParent(std::stack< std::tuple<int,double,double,double> >& queue)
-// The parent cell is the working cell 1st in the queue, so remove first element
-{
-    queue.pop();
-}
-
-void Grid_manager::addOffspring(std::tuple<int,double,double,double> cellSpecs,
-	std::stack< std::tuple<int,double,double,double> >& queue)
-// offspring cells are quadrants of parent cell
-{
-	// cellSpecs[0] is placeholder for ID number
-    double x = std::get<1>(cellSpecs);
-    double y = std::get<2>(cellSpecs);
-    double s = std::get<3>(cellSpecs);
-
-    // lower left quadrant: same x/y, side/2
-    auto lowerLeft = std::make_tuple(0, x, y, s/2);
-    // lower right quadrant: add side/2 to x, same y, side/2
-    auto lowerRight = std::make_tuple(0, x+s/2, y, s/2);
-    // upper left quadrant: same x, add side/2 to y, side/2
-    auto upperLeft = std::make_tuple(0, x, y+s/2, s/2);
-    // upper right quadrant: add side/2 to x and y, side/2
-    auto upperRight = std::make_tuple(0, x+s/2, y+s/2, s/2);
-
-    // add offspring cells to queue (in reverse order so lower left is first)
-    queue.emplace(upperRight);
-    queue.emplace(upperLeft);
-    queue.emplace(lowerRight);
-    queue.emplace(lowerLeft);
-}
-
 void Grid_manager::commitCell(std::tuple<int,double,double,double> cellSpecs, std::vector<Farm*>& farmsInCell)
 // write cellSpecs as class Grid_cell into set allCells
 {
@@ -485,37 +461,68 @@ void Grid_manager::commitCell(std::tuple<int,double,double,double> cellSpecs, st
 
     committedFarms += farmsInCell.size();
     assignCellIDtoFarms(id,farmsInCell);
-    removeFarmSubset(farmsInCell, farmList);
 if (verbose>1){std::cout<<"Cell committed, id "<<id<<std::endl;}
 }
 
-void Grid_manager::splitCell(std::tuple<int,double,double,double>& cellSpecs,
-	std::stack< std::tuple<int,double,double,double> >& queue)
+/// Premises in node are partitioned in place into quadrants (lower left, lower right,
+/// upper left, upper right), keeping their order within each quadrant, then each
+/// quadrant is split in turn. Premises on a boundary between quadrants go to the first of
+/// them in that order. Squares with no premises are dropped. Squares that are not split
+/// further, or are at stopDepth, are added to output in depth-first order, so that the
+/// premises of squares in output are in order in prems (a Z-order curve).
+/// \param[in,out] prems Premises, rearranged within node's range
+/// \param[in] node Square to split
+/// \param[in] maxPrems Squares with fewer premises than this are not split
+/// \param[in] minCutoff Squares with smaller sides than this are not split
+/// \param[in] depth Number of splits from the first square to node
+/// \param[in] stopDepth Squares at this depth are added to output without splitting (-1 for no limit)
+/// \param[out] output Squares to commit as cells (or to split further, if at stopDepth)
+void Grid_manager::splitQuadrants(std::vector<Farm*>& prems, const Quad_node& node,
+	const unsigned int maxPrems, const int minCutoff, int depth, const int stopDepth,
+	std::vector<Quad_node>& output)
 {
-    removeParent(queue);
-    addOffspring(cellSpecs,queue);
+	if (node.begin == node.end){return;} // no premises, not committed
+	if (node.s < minCutoff || node.end - node.begin < maxPrems || depth == stopDepth){
+		output.emplace_back(node);
+		return;
+	}
+	double half = node.s/2;
+	double midX = node.x + half;
+	double midY = node.y + half;
+	auto first = prems.begin() + node.begin;
+	auto last = prems.begin() + node.end;
+	auto lowerEnd = std::stable_partition(first, last, [midY](const Farm* f){return f->get_y() <= midY;});
+	auto lowerLeftEnd = std::stable_partition(first, lowerEnd, [midX](const Farm* f){return f->get_x() <= midX;});
+	auto upperLeftEnd = std::stable_partition(lowerEnd, last, [midX](const Farm* f){return f->get_x() <= midX;});
+	size_t b1 = lowerLeftEnd - prems.begin();
+	size_t b2 = lowerEnd - prems.begin();
+	size_t b3 = upperLeftEnd - prems.begin();
+	splitQuadrants(prems, {node.x, node.y, half, node.begin, b1}, maxPrems, minCutoff, depth+1, stopDepth, output);
+	splitQuadrants(prems, {midX, node.y, half, b1, b2}, maxPrems, minCutoff, depth+1, stopDepth, output);
+	splitQuadrants(prems, {node.x, midY, half, b2, b3}, maxPrems, minCutoff, depth+1, stopDepth, output);
+	splitQuadrants(prems, {midX, midY, half, b3, node.end}, maxPrems, minCutoff, depth+1, stopDepth, output);
 }
 
 void Grid_manager::assignCellIDtoFarms(int cellID, std::vector<Farm*>& farmsInCell)
 {
-	for (auto& f:farmsInCell){
-		f->set_cellID(cellID);
+	// farmsInCell is in the same order as the cell's premises
+	for (size_t i = 0; i < farmsInCell.size(); i++){
+		farmsInCell[i]->set_cellID(cellID, i);
 	}
 }
 
-void Grid_manager::initiateGrid(const unsigned int in_maxFarms, const int minCutoff)
-// maxFarms: If cell contains at least this many farms, subdivision will continue
-// minCutoff: minimum cell size
+/// Starts with a square covering all premises, and splits squares into quadrants while
+/// they have at least maxPrems premises and sides of at least minCutoff. Premises are
+/// partitioned in place rather than searched for in each square, so the cost is about
+/// (number of premises) x (number of levels). The first few levels are split on one
+/// thread, then the resulting squares are split on several threads.
+/// \param[in] maxPrems Cells with at least this many premises are split
+/// \param[in] minCutoff Cells with smaller sides than this are not split
+/// \param[out] prems All premises, in ID order within each cell and in cell order overall
+/// \param[out] cells Cells numbered depth-first, lower left quadrant first
+void Grid_manager::densityCells(const unsigned int maxPrems, const int minCutoff,
+	std::vector<Farm*>& prems, std::vector<Quad_node>& cells)
 {
-	set_maxFarms(in_maxFarms);
-	if (verbose > 0){
-	std::cout << "Max farms set to " << maxFarms << std::endl;
-	}
-    if(verbose>0){std::cout << "Splitting into grid cells..." << std::endl;}
- 	int cellCount = 0;
-    std::stack<std::tuple<int,double,double,double>> queue;// temporary list of cells to check for meeting criteria for commitment
-    std::vector<Farm*> farmsInCell; // vector of (pointers to) farms in working cell - using vector to get to specific elements
-
     double min_x = std::get<0>(xylimits)-0.1;
     double max_x = std::get<1>(xylimits)+0.1;
     double min_y = std::get<2>(xylimits)-0.1;
@@ -534,73 +541,70 @@ void Grid_manager::initiateGrid(const unsigned int in_maxFarms, const int minCut
        side_x = side_y;
     if(verbose>1){std::cout << "Using larger value " << side_x << std::endl;}
 
-    // add cell specifications to temporary tuple
-    std::tuple<int,double,double,double> cellSpecs = std::make_tuple(cellCount, min_x, min_y, side_x);
-    if(verbose>1){std::cout << "cellSpecs: " << std::get<0>(cellSpecs) <<", "<< std::get<1>(cellSpecs)
-    	<<", "<< std::get<2>(cellSpecs) <<", "<< std::get<3>(cellSpecs) << std::endl;}
-
-    // add initial cell to the queue
-    queue.emplace(cellSpecs);
-
-    // while there are any items in queue
-    while(queue.size()>0)
-    {
-    if(verbose>1){std::cout << std::endl << "Queue length = " << queue.size() << std::endl;}
-    cellSpecs = queue.top(); // set first in queue as working cell
+	// farmList is sorted by ID, and partitioning keeps that order within each cell
+	prems = farmList;
+	unsigned int nThreads = threadsToUse(parameters->nThreads);
+	if (verbose>1){nThreads = 1;} // keeps output in order
+	// split the first levels on one thread, into up to 4^stopDepth squares
+	int stopDepth = nThreads > 1 ? 4 : -1;
+	std::vector<Quad_node> subtrees;
+	splitQuadrants(prems, {min_x, min_y, side_x, 0, prems.size()}, maxPrems, minCutoff, 0, stopDepth, subtrees);
+	if (stopDepth < 0){
+		cells.swap(subtrees);
+		return;
+	}
+	// then split each of those (independent ranges of prems) on several threads
+	std::vector<std::vector<Quad_node>> leaves(subtrees.size());
+	std::atomic<size_t> nextSubtree(0);
+	auto splitSubtrees = [&](){
+		for (size_t i = nextSubtree++; i < subtrees.size(); i = nextSubtree++){
+			splitQuadrants(prems, subtrees[i], maxPrems, minCutoff, stopDepth, -1, leaves[i]);
+		}
+	};
+	if (nThreads > subtrees.size()){nThreads = subtrees.size();}
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < nThreads; i++){workers.emplace_back(splitSubtrees);}
+	splitSubtrees();
+	for (auto& w:workers){w.join();}
+	cells.clear();
+	for (auto& subtreeLeaves:leaves){cells.insert(cells.end(), subtreeLeaves.begin(), subtreeLeaves.end());}
+}
 
-	if(verbose>1){
-    	std::cout << "Cell side length = " << std::get<3>(cellSpecs) << ". ";
-    }
+/// Cells are numbered depth-first, lower left quadrant first, and premises in a cell are
+/// in ID order.
+void Grid_manager::initiateGrid(const unsigned int in_maxFarms, const int minCutoff)
+// maxFarms: If cell contains at least this many farms, subdivision will continue
+// minCutoff: minimum cell size
+{
+	set_maxFarms(in_maxFarms);
+	if (verbose > 0){
+	std::cout << "Max farms set to " << maxFarms << std::endl;
+	}
+    if(verbose>0){std::cout << "Splitting into grid cells..." << std::endl;}
+	std::chrono::steady_clock::time_point split_start = std::chrono::steady_clock::now();
+	std::vector<Farm*> prems;
+	std::vector<Quad_node> cells;
+	densityCells(maxFarms, minCutoff, prems, cells);
 
-	// Case A: side length of cell is smaller than kernel - immediate commit
-	if (std::get<3>(cellSpecs) < minCutoff){ // if side < kernel diameter
-		farmsInCell = getFarms(cellSpecs); // want ALL farms, so don't include maxFarms as argument
-		if (farmsInCell.size() > 0){ // if there are farms in cell, commit
-        	std::get<0>(cellSpecs) = cellCount;
-        	commitCell(cellSpecs,farmsInCell);
-        	cellCount = cellCount+1;
-        	if (verbose==2){std::cout << "Side smaller than kernel diameter.";}
-        	queue.pop(); // remove parent cell from front of queue
-        } else { // no farms in cell, remove from queue w/o committing
-        	queue.pop(); // remove parent cell from front of queue
-            if(verbose==2){std::cout << "No farms, removed cell, queue length = " << queue.size() << std::endl;}
-        }
-    // Case B: side length of cell >= minimum, check farm density and split if needed
-    } else if (std::get<3>(cellSpecs) >= minCutoff){ // side >= kernel diameter
-    	if(verbose==2){std::cout << "Side bigger than kernel, stepping in..." << std::endl;}
-    	farmsInCell = getFarms(cellSpecs, maxFarms); // copy up to maxFarms farms in cell to farmsInCell)
-    	if(verbose==2){std::cout << "Farms in cell = " << farmsInCell.size() << std::endl;}
-        if (farmsInCell.size() >= maxFarms){
-        // if farm density too high, split
-			if(verbose==2){std::cout << "Too many farms, splitting cell..." << std::endl;}
-			splitCell(cellSpecs,queue);
-        }
-        else if (farmsInCell.size() > 0 && farmsInCell.size() < maxFarms){
-        // farm density is below maximum, commit
-            	std::get<0>(cellSpecs) = cellCount;
-                commitCell(cellSpecs,farmsInCell);
-                cellCount = cellCount+1;
-                if (verbose>1){std::cout << "Cell committed: #" << cellCount<<std::endl;}
-                queue.pop(); // remove parent cell from front of queue
-            }
-        else if (farmsInCell.empty()){
-        // cell has no farms at all - remove from queue w/o committing
-            queue.pop(); // remove parent cell from front of queue
-            if(verbose==2){std::cout << "No farms, removed cell, queue length = "
-            	<< queue.size() << std::endl;}
-        }
-    }
-    } // end "while anything in queue"
+	// commit cells in depth-first order
+	int cellCount = 0;
+	for (auto& cell:cells){
+		std::vector<Farm*> farmsInCell(prems.begin() + cell.begin, prems.begin() + cell.end);
+		commitCell(std::make_tuple(cellCount, cell.x, cell.y, cell.s), farmsInCell);
+		++cellCount;
+	}
+	farmList.clear();
+	std::chrono::steady_clock::time_point split_end = std::chrono::steady_clock::now();
 
 if (verbose){
 	std::cout << "Grid of "<< allCells.size()<<" cells created, with min side "<<minCutoff<<
-	" and max "<<maxFarms<<" farms. Pre-calculating distances..." << std::endl;
+	" and max "<<maxFarms<<" farms, in " <<
+	std::chrono::duration_cast<std::chrono::milliseconds>(split_end - split_start).count() <<
+	"ms. Pre-calculating distances..." << std::endl;
 }
 	if (farm_map.size()!=committedFarms){
 		std::cout<<"ERROR: "<<committedFarms<<" farms committed, expected "
 		<<farm_map.size()<<std::endl;
-		for (auto& dropped:farmList){std::cout<<"ID "<<dropped->get_id()<<", x "
-			<<dropped->get_x()<<", y "<<dropped->get_y()<<std::endl;}
 		Rcpp::stop("");
 		}
 	makeCellRefs();
@@ -608,6 +612,131 @@ if (verbose){
 	if (printCellFile > 0){printCells();}
 }
 
+/// Tries grids by density with maximum premises per cell from 16 to 2048 (doubling), and
+/// each minimum side that stops splitting at a different level of quadrants, and builds
+/// the one with the lowest predicted cost (see predictedCost). Grids with more than
+/// 20000 cells are not tried, as the cell kernel matrix would get too large.
+void Grid_manager::initiateGrid()
+{
+	std::chrono::steady_clock::time_point tune_start = std::chrono::steady_clock::now();
+	const size_t maxTunedCells = 20000;
+	// side of the first square, as in densityCells
+	double side = std::max((std::get<1>(xylimits)+0.1) - (std::get<0>(xylimits)-0.1),
+		(std::get<3>(xylimits)+0.1) - (std::get<2>(xylimits)-0.1));
+	unsigned int bestMaxFarms = 0;
+	int bestMinCutoff = 0;
+	size_t bestCells = 0;
+	double bestCost = -1;
+	std::vector<Farm*> prems;
+	std::vector<Quad_node> cells;
+	int tried = 0;
+	for (unsigned int maxPrems = 16; maxPrems <= 2048; maxPrems *= 2){
+		bool deeperDiffers = true;
+		for (int level = 1; level <= 30 && deeperDiffers; level++){
+			// squares at this level (side/2^level) are not split, larger ones can be
+			double levelSide = side / double(1ULL << level);
+			if (levelSide < 1){break;}
+			int minCutoff = int(levelSide) + 1;
+			densityCells(maxPrems, minCutoff, prems, cells);
+			if (cells.size() > maxTunedCells){break;}
+			// a lower min side only changes the grid if a cell at this level would be split
+			deeperDiffers = std::any_of(cells.begin(), cells.end(), [&](const Quad_node& n){
+				return n.s <= levelSide && n.end - n.begin >= maxPrems;});
+			double cost = predictedCost(prems, cells);
+			++tried;
+if (verbose>1){std::cout << "Grid by density with max " << maxPrems << " premises, min side " << minCutoff <<
+	": " << cells.size() << " cells, predicted cost " << cost << std::endl;}
+			if (bestCost < 0 || cost < bestCost){
+				bestCost = cost;
+				bestMaxFarms = maxPrems;
+				bestMinCutoff = minCutoff;
+				bestCells = cells.size();
+			}
+		}
+	}
+	std::chrono::steady_clock::time_point tune_end = std::chrono::steady_clock::now();
+	long long tuneMS = std::chrono::duration_cast<std::chrono::milliseconds>(tune_end - tune_start).count();
+	if (bestCost < 0){ // every grid tried had too many cells
+		bestMaxFarms = 2048;
+		bestMinCutoff = int(side) + 1;
+		std::cout << "Every grid by density tried had more than " << maxTunedCells <<
+			" cells, falling back to max " << bestMaxFarms << " premises per cell, min side " <<
+			bestMinCutoff << " (" << tuneMS << "ms)." << std::endl;
+	} else {
+		std::cout << "Grid parameters chosen from " << tried << " grids by density in " << tuneMS <<
+			"ms: max " << bestMaxFarms << " premises per cell, min side " << bestMinCutoff << " (" <<
+			bestCells << " cells), predicted cost " << bestCost <<
+			" per infectious premises per timestep." << std::endl;
+	}
+	initiateGrid(bestMaxFarms, bestMinCutoff);
+	std::ostringstream tuned;
+	tuned << bestMaxFarms << "," << bestMinCutoff << "," << allCells.size() << ",";
+	if (bestCost < 0){tuned << "fallback";} else {tuned << bestCost;}
+	tunedGrid = tuned.str();
+}
+
+/// Expected work for local spread from one infectious premises in one timestep, taking
+/// infectious premises to be spread like all premises. Work is counted in cell checks:
+/// each (focal, comparison) cell pair with a nonzero kernel costs one, plus one for each
+/// premises the local spread method (config 16) evaluates in the comparison cell:
+/// - 1, 2 (pairwise): every premises
+/// - 0 (gridding), 4 (skipping ahead): the premises that pass the pmax filter, using the
+///		mean maximum infectiousness of premises in the focal cell
+/// - 3 (cell pairs): the pairs that pass the pmax filter, which uses the largest maximum
+///		infectiousness in the focal cell. The cell check is counted in full, as if the
+///		focal farm were alone in its cell.
+///
+/// The kernel value of a cell pair is taken at the shortest distance between the cells
+/// (as in makeCellRefs). The sum is over all comparison cells for up to 256 focal cells,
+/// chosen in proportion to their premises.
+/// \param[in] prems All premises, in order of cells
+/// \param[in] cells Cells of the grid, as ranges of prems
+double Grid_manager::predictedCost(const std::vector<Farm*>& prems, const std::vector<Quad_node>& cells)
+{
+	if (cells.empty()){return 0;}
+	double dcScale = 1;
+	if (parameters->dangerousContacts_on){dcScale = parameters->maxDCScale;}
+	int method = parameters->localSpreadMethod;
+	std::vector<double> maxSus(cells.size(), 0);
+	std::vector<double> focalInfMax(cells.size(), 0); // infectiousness used for pmax from each cell
+	for (size_t c = 0; c < cells.size(); c++){
+		for (size_t i = cells[c].begin; i < cells[c].end; i++){
+			maxSus[c] = std::max(maxSus[c], prems[i]->get_sus_max());
+			if (method == 3){
+				focalInfMax[c] = std::max(focalInfMax[c], prems[i]->get_inf_max());
+			} else {
+				focalInfMax[c] += prems[i]->get_inf_max();
+			}
+		}
+		if (method != 3){focalInfMax[c] /= (cells[c].end - cells[c].begin);}
+	}
+	const size_t maxSamples = 256;
+	size_t nSamples = std::min(maxSamples, cells.size());
+	double total = 0;
+	size_t c1 = 0;
+	for (size_t sample = 0; sample < nSamples; sample++){
+		// cell holding the premises at this fraction of the way through prems
+		size_t position = size_t((sample + 0.5) * prems.size() / nSamples);
+		while (cells[c1].end <= position){++c1;}
+		const Quad_node& fc = cells[c1];
+		for (size_t c2 = 0; c2 < cells.size(); c2++){
+			const Quad_node& cc = cells[c2];
+			double xGap = std::max(0.0, std::max(cc.x - (fc.x + fc.s), fc.x - (cc.x + cc.s)));
+			double yGap = std::max(0.0, std::max(cc.y - (fc.y + fc.s), fc.y - (cc.y + cc.s)));
+			double kern = kernel->atDistSq(xGap*xGap + yGap*yGap) * maxSus[c2] * dcScale;
+			if (kern <= 0){continue;}
+			double n2 = cc.end - cc.begin;
+			total += 1;
+			if (method == 1 || method == 2){
+				total += n2;
+			} else {
+				total += n2 * oneMinusExp(-focalInfMax[c1] * kern);
+			}
+		}
+	}
+	return total / nSamples;
+}
+
 void Grid_manager::initiateGrid(std::string& cname)
 // overloaded (alternate) constructor that reads in external file of cells
 {
@@ -880,7 +1009,7 @@ double Grid_manager::shortestCellDist2(Grid_cell* cell1, Grid_cell* cell2)
 		{
  		if(verbose>1){std::cout << "east of and ";}
 		cell1_x = cell1_West;
-		cell2_x = cell1_East;
+		cell2_x = cell2_East;
 		}
 	// or cell1 is directly atop all or part of cell2
 	else // if ((cell1_East > cell2_West) && (cell1_West < cell2_East))
@@ -924,63 +1053,289 @@ return cellDist2;
 }
 
 /// Calculates kernel values * max susceptibility (susxKern) for each pair of Grid_cells.
-/// Stored with each Grid_cell is a map with all other cells as keys, with values susxKern
+/// Values are stored in cellKernel, indexed by cell ID, and each Grid_cell points to it.
 /// Neighbors (other Grid_cells with shortest distance = 0) are also stored with each Grid_cell
 void Grid_manager::makeCellRefs()
 // Although all the ID referencing seems a bit much, this is one way to ensure the order of the cells checked
 {
-	std::unordered_map<Grid_cell*, std::unordered_map<int, double> > susxKern;
-
-	for (unsigned int whichCell1=0; whichCell1 != allCells.size(); ++whichCell1){
-		Grid_cell* cell1 = allCells.at(whichCell1);
-		for (unsigned int whichCell2 = whichCell1; whichCell2 != allCells.size(); ++whichCell2){
-			Grid_cell* cell2 = allCells.at(whichCell2);
-			// get distance between grid cells 1 and 2...
-			// if comparing to self, distance=0
-			double shortestDist2 = 0;
-			if (whichCell2 != whichCell1) { // overwrite if cells are different
-				shortestDist2 = shortestCellDist2(cell1, cell2);
+	std::chrono::steady_clock::time_point refStart = std::chrono::steady_clock::now();
+	unsigned int nCells = allCells.size();
+	// cells are looked up by ID in the kernel matrix, so IDs must be 0 to (number of cells - 1)
+	std::vector<Grid_cell*> cellList(nCells, nullptr); // cells in ID order, avoids hashing for each pair
+	for (unsigned int whichCell=0; whichCell != nCells; ++whichCell){
+		if (allCells.count(whichCell)==0){
+			std::cout << "ERROR: Grid cell IDs must run consecutively from 0 to "<<nCells-1<<
+			", cell "<<whichCell<<" not found. Exiting..." << std::endl;
+			Rcpp::stop("");
+		}
+		cellList[whichCell] = allCells.at(whichCell);
+	}
+
+	double dcScale = 1;
+	if (parameters->dangerousContacts_on){dcScale = parameters->maxDCScale;}
+
+	// Pairs are split into square blocks of cells on or above the diagonal. Each block
+	// writes both directions of only its own pairs, so blocks can be filled by
+	// different threads without locking.
+	const unsigned int blockSize = 64; // cells per side of a block
+	unsigned int nBlocks = (nCells + blockSize - 1)/blockSize;
+	std::vector<std::pair<unsigned int, unsigned int>> blocks;
+	for (unsigned int b1 = 0; b1 < nBlocks; b1++){
+		for (unsigned int b2 = b1; b2 < nBlocks; b2++){
+			blocks.emplace_back(b1, b2);
+		}
+	}
+	unsigned int nThreads = threadsToUse(parameters->nThreads);
+	if (verbose>1){nThreads = 1;} // keeps per-pair output in order
+	if (nThreads > blocks.size()){nThreads = blocks.size();}
+	if (nThreads == 0){nThreads = 1;}
+
+	std::vector<std::vector<std::pair<int, int>>> adjacent(nThreads); // touching cells found by each thread
+	std::vector<std::vector<Kernel_matrix::Entry>> kernelEntries(nThreads); // non-zero values found by each thread
+	std::atomic<size_t> nextBlock(0);
+	auto fillBlocks = [&](unsigned int threadNum){
+		for (size_t b = nextBlock++; b < blocks.size(); b = nextBlock++){
+			unsigned int first1 = blocks[b].first*blockSize;
+			unsigned int end1 = std::min(first1+blockSize, nCells);
+			unsigned int first2 = blocks[b].second*blockSize;
+			unsigned int end2 = std::min(first2+blockSize, nCells);
+			for (unsigned int whichCell1 = first1; whichCell1 != end1; ++whichCell1){
+				Grid_cell* cell1 = cellList[whichCell1];
+				double maxS1 = cell1->Grid_cell::get_maxSus();
+				for (unsigned int whichCell2 = std::max(first2, whichCell1); whichCell2 != end2; ++whichCell2){
+					Grid_cell* cell2 = cellList[whichCell2];
+					// get distance between grid cells 1 and 2...
+					// if comparing to self, distance=0
+					double shortestDist2 = 0;
+					if (whichCell2 != whichCell1) { // overwrite if cells are different
+						shortestDist2 = shortestCellDist2(cell1, cell2);
 if(verbose>1){std::cout << "Distance squared between "<<whichCell1<<" & "<<whichCell2<<": "<<shortestDist2<<std::endl;}
-			}
-			// save adjacent neighbors, not including self (for distance-based control)
-			if (shortestDist2 == 0 && whichCell1 != whichCell2){
-				cell1->addNeighbor(cell2);
-				cell2->addNeighbor(cell1);
-			}
-			// kernel value between c1, c2
-			double gridValue = kernel->atDistSq(shortestDist2);
+					}
+					// save adjacent neighbors, not including self (for distance-based control)
+					if (shortestDist2 == 0 && whichCell1 != whichCell2){
+						adjacent[threadNum].emplace_back(whichCell1, whichCell2);
+					}
+					// kernel value between c1, c2
+					double gridValue = kernel->atDistSq(shortestDist2);
 if(verbose>1){std::cout << "Kernel between "<<whichCell1<<"&"<<whichCell2<<": "<<gridValue<<std::endl;}
-				// store kernel * max sus (part of all prob calculations)
-				double maxS2 = cell2->Grid_cell::get_maxSus();
-				if (parameters->dangerousContacts_on){
-					susxKern[cell1][whichCell2] = maxS2 * gridValue * (parameters->maxDCScale);
-				} else {
-					susxKern[cell1][whichCell2] = maxS2 * gridValue;
-				}
+					// store kernel * max sus (part of all prob calculations)
+					double maxS2 = cell2->Grid_cell::get_maxSus();
+					if (maxS2 * gridValue * dcScale > 0){
+						kernelEntries[threadNum].push_back({int(whichCell1), int(whichCell2), maxS2 * gridValue * dcScale});
+					}
 if(verbose>1){std::cout << "Stored in-range sus*kernel: cells "<<whichCell1<<" & "<<whichCell2<<", susxKern: "<<
-	susxKern.at(cell1).at(whichCell2)<<std::endl;}
-
-				// if not comparing to self, calc/store other direction (this was a big bug - double counting self as neighbor)
-				if (whichCell1 != whichCell2){
-					double maxS1 = cell1->Grid_cell::get_maxSus();
-					if (parameters->dangerousContacts_on){
-						susxKern[cell2][whichCell1] = maxS1 * gridValue * (parameters->maxDCScale);
-					} else {
- 						susxKern[cell2][whichCell1] = maxS1 * gridValue;
- 					}
- if(verbose>1){std::cout << "Stored in-range sus*kernel: cells "<<whichCell2<<" & "<<whichCell1<<", susxKern: "<<
- 	susxKern.at(cell2).at(whichCell1)<<std::endl;}
-				}
-		} // end for each cell2
-	} // end for each cell1
+	maxS2 * gridValue * dcScale<<std::endl;}
 
-	// assign kernel maps to individual cells
-	for (auto& k:susxKern){
-		k.first->take_KernelValues(k.second);
+					// if not comparing to self, calc/store other direction (this was a big bug - double counting self as neighbor)
+					if (whichCell1 != whichCell2){
+						if (maxS1 * gridValue * dcScale > 0){
+							kernelEntries[threadNum].push_back({int(whichCell2), int(whichCell1), maxS1 * gridValue * dcScale});
+						}
+if(verbose>1){std::cout << "Stored in-range sus*kernel: cells "<<whichCell2<<" & "<<whichCell1<<", susxKern: "<<
+	maxS1 * gridValue * dcScale<<std::endl;}
+					}
+				} // end for each cell2
+			} // end for each cell1
+		} // end for each block
+	};
+	if (nThreads == 1){
+		fillBlocks(0);
+	} else {
+		std::vector<std::thread> workers;
+		for (unsigned int i = 0; i < nThreads; i++){
+			workers.emplace_back(fillBlocks, i);
+		}
+		for (auto& w:workers){w.join();}
+	}
+
+	// add neighbors in ID order, regardless of which thread found them
+	std::vector<std::vector<int>> neighborIDs(nCells);
+	for (auto& threadPairs:adjacent){
+		for (auto& a:threadPairs){
+			neighborIDs[a.first].emplace_back(a.second);
+			neighborIDs[a.second].emplace_back(a.first);
+		}
+	}
+	for (unsigned int whichCell=0; whichCell != nCells; ++whichCell){
+		std::sort(neighborIDs[whichCell].begin(), neighborIDs[whichCell].end());
+		for (auto& n:neighborIDs[whichCell]){
+			cellList[whichCell]->addNeighbor(cellList[n]);
+		}
 	}
 
+	// record which cells each cell can reach, with their non-zero values
+	cellKernel.build(nCells, kernelEntries);
+	for (auto& c:cellList){
+		c->set_susxKernel(&cellKernel);
+	}
 
-if (verbose>0){std::cout << "Kernel distances and neighbors recorded." << std::endl;}
+	std::chrono::steady_clock::time_point refEnd = std::chrono::steady_clock::now();
+if (verbose>0){std::cout << "Kernel distances and neighbors recorded for "<<nCells<<" cells ("<<
+	(cellKernel.is_dense() ? "dense" : "sparse")<<" matrix, "<<
+	cellKernel.get_memoryBytes()/1048576.0<<" MB) in "<<
+	std::chrono::duration_cast<std::chrono::milliseconds>(refEnd - refStart).count()<<
+	"ms on "<<nThreads<<" thread(s)." << std::endl;}
+}
+
+/// Hash identifying the inputs a grid cache was built from, stored in the cache file and
+/// checked when it is loaded. Combines everything the cells, neighbors and kernel values depend on: the premises
+/// file contents, grid settings (and cell file contents), kernel settings (and data kernel
+/// file contents), and species susceptibility/infectiousness values.
+unsigned long long Grid_manager::gridCacheKey()
+{
+	std::ostringstream settings;
+	settings.precision(17);
+	settings << parameters->reverseXY << "\t" << parameters->cellFile << "\t" <<
+		parameters->uniformSide << "\t";
+	for (auto& d:parameters->densityParams){settings << d << ",";}
+	settings << "\t" << parameters->kernelType << "\t";
+	for (auto& k:parameters->kernelParams){settings << k << ",";}
+	settings << "\t" << parameters->kernelTableError; // table values are used for cell kernel values
+	if (parameters->gridAutoTune){settings << "\tauto," << parameters->localSpreadMethod;} // chosen grid depends on spread method
+	for (auto& sp:parameters->species){
+		settings << "\t" << sp << "," << parameters->susExponents.at(sp) << "," <<
+			parameters->infExponents.at(sp) << "," << parameters->susConsts.at(sp) << "," <<
+			parameters->infConsts.at(sp);
+	}
+	if (parameters->dangerousContacts_on){settings << "\tDC," << parameters->maxDCScale;}
+	std::string settingsString = settings.str();
+
+	unsigned long long key = hashBytes(settingsString.data(), settingsString.size());
+	key = hashFile(parameters->premFile, key);
+	if (parameters->cellFile != "*"){key = hashFile(parameters->cellFile, key);}
+	if (parameters->kernelType == 1){key = hashFile(parameters->dataKernelFile, key);}
+	return key;
+}
+
+/// Writes the cells, neighbors and kernel values so later runs with the same inputs can
+/// skip building the grid. File layout: identifier, version, input key, then for each cell
+/// (in ID order) its position, side and premises IDs, then each cell's neighbor IDs, then
+/// the kernel matrix, then the automatically chosen grid parameters (see get_tunedGrid).
+void Grid_manager::saveGridCache()
+{
+	if (parameters->gridCacheFile == "*"){return;}
+	// write to a temporary file and rename, so other runs never read a partial cache (the
+	// process ID keeps runs saving at the same time from writing the same temporary file)
+	std::string tempName = parameters->gridCacheFile + "." + std::to_string(processID()) + ".tmp";
+	std::ofstream f(tempName, std::ios::binary);
+	if (!f){
+		std::cout << "Warning (config 39): Grid cache file " << parameters->gridCacheFile <<
+			" could not be written." << std::endl;
+		return;
+	}
+	f.write(gridCacheID, sizeof(gridCacheID));
+	writeBinary(f, gridCacheVersion);
+	writeBinary(f, gridCacheKey());
+	unsigned int nCells = allCells.size();
+	writeBinary(f, nCells);
+	for (unsigned int whichCell = 0; whichCell != nCells; ++whichCell){
+		Grid_cell* c = allCells.at(whichCell);
+		writeBinary(f, c->get_x());
+		writeBinary(f, c->get_y());
+		writeBinary(f, c->get_s());
+		std::vector<int> farmIDs;
+		for (auto& prem:c->get_farms()){farmIDs.emplace_back(prem->get_id());}
+		writeBinaryVec(f, farmIDs);
+	}
+	for (unsigned int whichCell = 0; whichCell != nCells; ++whichCell){
+		std::vector<int> neighborIDs;
+		for (auto& n:*(allCells.at(whichCell)->get_neighbors())){neighborIDs.emplace_back(n->get_id());}
+		writeBinaryVec(f, neighborIDs);
+	}
+	cellKernel.write(f);
+	writeBinaryVec(f, std::vector<char>(tunedGrid.begin(), tunedGrid.end()));
+	f.close();
+	bool renamed = f && std::rename(tempName.c_str(), parameters->gridCacheFile.c_str()) == 0;
+	if (f && !renamed){ // rename doesn't replace an existing file on Windows
+		std::remove(parameters->gridCacheFile.c_str());
+		renamed = std::rename(tempName.c_str(), parameters->gridCacheFile.c_str()) == 0;
+	}
+	if (!renamed){
+		std::cout << "Warning (config 39): Grid cache file " << parameters->gridCacheFile <<
+			" could not be written." << std::endl;
+		std::remove(tempName.c_str());
+		return;
+	}
+if (verbose>0){std::cout << "Grid saved to cache file " << parameters->gridCacheFile << std::endl;}
+}
+
+/// Checks the cache file's identifier, version and input key, and reads the whole file
+/// before making any cells, so an outdated or incomplete cache leaves the grid unchanged.
+bool Grid_manager::loadGridCache()
+{
+	if (parameters->gridCacheFile == "*"){return false;}
+	std::ifstream f(parameters->gridCacheFile, std::ios::binary);
+	if (!f){
+		std::cout << "Grid cache file " << parameters->gridCacheFile << " not found, building grid." << std::endl;
+		return false;
+	}
+	char inID[sizeof(gridCacheID)];
+	unsigned int inVersion = 0;
+	unsigned long long inKey = 0;
+	f.read(inID, sizeof(inID));
+	if (!f || !std::equal(inID, inID+sizeof(inID), gridCacheID) ||
+		!readBinary(f, inVersion) || inVersion != gridCacheVersion ||
+		!readBinary(f, inKey) || inKey != gridCacheKey()){
+		std::cout << "Grid cache file " << parameters->gridCacheFile <<
+			" is from a different version or inputs, building grid." << std::endl;
+		return false;
+	}
+
+	// read everything before changing the grid, in case the file is incomplete
+	unsigned int nCells = 0;
+	bool complete = readBinary(f, nCells);
+	std::vector<double> cellX(nCells), cellY(nCells), cellS(nCells);
+	std::vector<std::vector<int>> farmIDs(nCells), neighborIDs(nCells);
+	for (unsigned int whichCell = 0; complete && whichCell != nCells; ++whichCell){
+		complete = readBinary(f, cellX[whichCell]) && readBinary(f, cellY[whichCell]) &&
+			readBinary(f, cellS[whichCell]) && readBinaryVec(f, farmIDs[whichCell]);
+		for (auto& id:farmIDs[whichCell]){
+			if (farm_map.count(id) == 0){complete = false;}
+		}
+	}
+	for (unsigned int whichCell = 0; complete && whichCell != nCells; ++whichCell){
+		complete = readBinaryVec(f, neighborIDs[whichCell]);
+		for (auto& id:neighborIDs[whichCell]){
+			if (id < 0 || (unsigned int)id >= nCells){complete = false;}
+		}
+	}
+	complete = complete && cellKernel.read(f) && cellKernel.get_n() == nCells;
+	std::vector<char> inTunedGrid;
+	complete = complete && readBinaryVec(f, inTunedGrid);
+	if (!complete){
+		std::cout << "Grid cache file " << parameters->gridCacheFile << " is incomplete, building grid." << std::endl;
+		cellKernel = Kernel_matrix();
+		return false;
+	}
+
+	// commit cells as in initiateGrid (only cells made by density are listed by county)
+	bool byDensity = parameters->cellFile == "*" && parameters->uniformSide <= 0;
+	for (unsigned int whichCell = 0; whichCell != nCells; ++whichCell){
+		std::vector<Farm*> farmsInCell;
+		farmsInCell.reserve(farmIDs[whichCell].size());
+		for (auto& id:farmIDs[whichCell]){farmsInCell.emplace_back(farm_map.at(id));}
+		Grid_cell* cellToAdd = new Grid_cell(whichCell, cellX[whichCell], cellY[whichCell],
+			cellS[whichCell], farmsInCell);
+		allCells.emplace(whichCell, cellToAdd);
+		if (byDensity){
+			for (auto& c:cellToAdd->get_counties()){cellsByCounty[c].emplace_back(cellToAdd);}
+		}
+		committedFarms += farmsInCell.size();
+		assignCellIDtoFarms(whichCell, farmsInCell);
+	}
+	for (unsigned int whichCell = 0; whichCell != nCells; ++whichCell){
+		Grid_cell* c = allCells.at(whichCell);
+		for (auto& id:neighborIDs[whichCell]){c->addNeighbor(allCells.at(id));}
+		c->set_susxKernel(&cellKernel);
+	}
+	farmList.clear();
+	tunedGrid.assign(inTunedGrid.begin(), inTunedGrid.end());
+
+if (verbose>0){std::cout << "Grid of " << nCells << " cells loaded from cache file " <<
+	parameters->gridCacheFile << " (" << (cellKernel.is_dense() ? "dense" : "sparse") <<
+	" matrix, " << cellKernel.get_memoryBytes()/1048576.0 << " MB)." << std::endl;}
+	if (printCellFile > 0){printCells();}
+	return true;
 }
 
 /// Used after grid creation to assign susceptibility values to individual premises
@@ -1339,215 +1694,26 @@ void Grid_manager::get_seedPremises(std::vector<std::vector<Farm*>>& output){
 	seedFarmsByRun.swap(output);
 }
 
-/// \param[in] compare_x x-coordinate of point to be evaluated
-/// \param[in] compare_y y-coordinate of point to be evaluated
-/// \param[in] center_x x-coordinate of center of circle
-/// \param[in] center_y y-coordinate of center of circle
-/// \param[in] radius radius of circle (same units as x and y points)
-/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
-double Grid_manager::pointDistanceWithinRadius(const double compare_x, const double compare_y,
-	const double center_x, const double center_y, const double radius, const double radiusSquared)
-{
-	double distanceOutput = -1; // default is not within radius (distance from center > radius)
-	const double xdiff = std::abs(compare_x - center_x);
-	const double ydiff = std::abs(compare_x - center_x);
-
-	if (xdiff <= radius && ydiff <= radius){ // only bother with calculation if differences for both x and y <= radius
-		double distanceSquared = xdiff*xdiff + ydiff*ydiff;
-		if (distanceSquared <= radiusSquared){ // check if within circle
-			distanceOutput = distanceSquared;
-		}
-	}
-	return distanceOutput;
-}
-
-/// \param[in] compare_x x-coordinate of point to be evaluated
-/// \param[in] compare_y y-coordinate of point to be evaluated
-/// \param[in] center_x x-coordinate of center of circle
-/// \param[in] center_y y-coordinate of center of circle
-/// \param[in] radius radius of circle (same units as x and y points)
-/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
-unsigned int Grid_manager::pointWithinRadius(const double compare_x, const double compare_y,
-	const double center_x, const double center_y, const double radius, const double radiusSquared)
-{
-	unsigned int output = 0;
-	double pointDist = pointDistanceWithinRadius(compare_x, compare_y, center_x, center_y,
-																							 radius, radiusSquared);
-	if (pointDist >= 0){
-		output = 1;
-	}
-	return output;
-}
-
-/// \param[in] cell Grid_cell to be evaluated
-/// \param[in] center_x x-coordinate of center of circle
-/// \param[in] center_y y-coordinate of center of circle
-/// \param[in] radius radius of circle (same units as x and y points)
-/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
-unsigned int Grid_manager::count_cellCornersWithinRadius(Grid_cell* cell, const double center_x,
-	const double center_y, const double radius, const double radiusSquared)
-{
-	// check if each corner is in radius
-	double north = cell->Grid_cell::get_north();
-	double south = cell->Grid_cell::get_south();
-	double east = cell->Grid_cell::get_east();
-	double west = cell->Grid_cell::get_west();
-
-	unsigned int swInRange = pointWithinRadius(west, south, center_x, center_y, radius, radiusSquared);
-	unsigned int nwInRange = pointWithinRadius(west, north, center_x, center_y, radius, radiusSquared);
-	unsigned int neInRange = pointWithinRadius(east, north, center_x, center_y, radius, radiusSquared);
-	unsigned int seInRange = pointWithinRadius(east, south, center_x, center_y, radius, radiusSquared);
-
-	// return total number of corners in range
-	unsigned int output = swInRange+nwInRange+neInRange+seInRange;
-
-	if (output <= 4){
-		return output;
-	} else {
-		std::cout << "ERROR: Grid_manager::cellCornersWithinRadius: wrong number of corners ("<< output
-		<< "). Exiting..." << std::endl;
-		Rcpp::stop("");
-	}
-}
-
-/// Checks if neighbors in a given radius have already been determined. If not, calls
-/// calc_neighborsInRadius, and returns neighbors in radius.
-void Grid_manager::get_neighborsInRadius(Farm* focal, const double radius,
-	const double radiusSquared, const bool distanceRequired, std::multimap<double, Farm*>& output)
-{
-	// check if focal Farm already has neighbors in designated radius
-	double checkedRadius = focal->Farm::get_neighborRadiusCalculated();
-
-	if (checkedRadius < radius){
-	// need to generate multimap of neighbors/distances
-		std::multimap<double, Farm*> dn; // blank multimap to be written to
-		calc_neighborsInRadius(focal, radius, radiusSquared, distanceRequired, dn);
-		dn.swap(output);
-	} else {
-	// neighbors have already been calculated at this radius or larger
-		// if distancesRequired, check for missing distance values (may happen when all prems in a cell are added)
-		if (distanceRequired == 1){
-			const std::multimap<double, Farm*>* dnCheck = focal->Farm::get_distancesNeighbors();
-			auto missingDistance = dnCheck->equal_range(-1);
-			// if any neighbors are missing distances, fill in
-			if (std::distance(missingDistance.first, missingDistance.second) > 0){
-				fill_premisesDistances(focal);
-			}
-		}
-		// point to focal premises' distances-neighbors
-		const std::multimap<double, Farm*>* dn = focal->Farm::get_distancesNeighbors();
-
-		// if neighbors calculated from larger radius, filter to this radius value
-		if (checkedRadius > radius){
-			auto endRange = dn->upper_bound(radius);
-			std::multimap<double, Farm*> tempOutput (dn->begin(), endRange);
-			tempOutput.swap(output);
-		} else if (checkedRadius == radius){
-			std::multimap<double, Farm*> tempOutput (*dn); // copy as-is
-			tempOutput.swap(output);
-		}
-	}
-
-}
-
-/// \param[in] focal Focal premises
+/// Returns premises within radius of any of the focal premises, each once, sorted by
+/// distance to the closest focal premises (ties by premises ID)
+/// \param[in] focals Focal premises
 /// \param[in] radius Radius (in same units as premises coordinates) to use as threshold
 /// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
 /// \param[out] output Vector to which premises within radius will be copied
-void Grid_manager::calc_neighborsInRadius(Farm* focal, const double radius,
-	const double radiusSquared, bool distanceRequired, std::multimap<double, Farm*>& output)
-{
-	const int focalCellID = focal->Farm::get_cellID();
-	const double center_x = focal->Farm::get_x();
-	const double center_y = focal->Farm::get_y();
-
-	std::vector<Grid_cell*> cellsToCheck;
-	cellsToCheck.emplace_back(allCells.at(focalCellID));
-	int index = 0;
-
-	std::multimap<double, Farm*> distancesNeighbors;
-
-	while (index < cellsToCheck.size()){
-		unsigned int numCornersInRadius = count_cellCornersWithinRadius(cellsToCheck.at(index),
-			center_x, center_y, radius, radiusSquared);
-		std::vector<Farm*> inCell = cellsToCheck.at(index)->Grid_cell::get_farms();
-
-		// if all corners are in radius, add all farms in cell as neighbors
-		if (numCornersInRadius ==4){
-			if (distanceRequired == 0){
-				add_premisesWithoutDistance(inCell, distancesNeighbors);
-			} else {
-				add_premisesInRadius(center_x, center_y, radius, radiusSquared, inCell, distancesNeighbors);
-			}
-			// get neighbors of this cell and add to queue
-			get_neighborCellsToCheck(cellsToCheck.at(index), cellsToCheck);
-		// if there are 1-3 corners in radius, check each farm in cell
-		} else if (numCornersInRadius >0 && numCornersInRadius <4){
-			// check if each farm in cell is in radius
-			add_premisesInRadius(center_x, center_y, radius, radiusSquared, inCell, distancesNeighbors);
-			// get neighbors of this cell and add to queue
-			get_neighborCellsToCheck(cellsToCheck.at(index), cellsToCheck);
-		// if there are no corners in radius, but this is the focal cell, check all farms in cell
-		} else if (numCornersInRadius == 0 && cellsToCheck.at(index)->Grid_cell::get_id() == focalCellID){
-			// cell corners are outside of radius but since this is the focal cell, check all farms within
-			add_premisesInRadius(center_x, center_y, radius, radiusSquared, inCell, distancesNeighbors);
-			// get neighbors of this cell and add to queue
-			//get_neighborCellsToCheck(cellsToCheck.at(index), cellsToCheck);
-		}
-		// otherwise, if numCornersInRadius is 0 and not focal cell, do nothing
-		index++;
-	}
-
-	output.swap(distancesNeighbors);
-
-	// can comment out next two lines for less memory usage
-	focal->Farm::set_distancesNeighbors(distancesNeighbors);
-	focal->Farm::set_neighborRadiusCalculated(radius);
-}
-
-/// \param[in] focalCell Grid_cell for which to retrieve neighboring cells
-/// \param[in] cellsToCheck Vector of cells to be checked, to which neighboring cells will be copied
-void Grid_manager::get_neighborCellsToCheck(Grid_cell* focalCell, std::vector<Grid_cell*>& cellsToCheck)
-{
-	const std::vector<Grid_cell*>* neighborCells = focalCell->Grid_cell::get_neighbors();
-	for (auto& nc:(*neighborCells)){
-		auto checkIfAdded = std::find(cellsToCheck.begin(), cellsToCheck.end(), nc);
-		if (checkIfAdded == cellsToCheck.end()){ // is not already in list
-			cellsToCheck.emplace_back(nc);
-		}
-	}
-}
-
-/// \param[in] center_x x-coordinate of center of circle
-/// \param[in] center_y y-coordinate of center of circle
-/// \param[in] radius radius of circle (same units as x and y points)
-/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
-/// \param[in] premisesToCheck Vector of premises to check for being within radius
-/// \param[in] neighbors Vector to which premises that are within radius are copied
-void Grid_manager::add_premisesInRadius(const double center_x, const double center_y,
-	const double radius, const double radiusSquared, const std::vector<Farm*>& premisesToCheck,
-	std::multimap<double, Farm*>& distancesNeighbors)
-{
-	for (auto& f:premisesToCheck){
-		double premisesDistance = pointDistanceWithinRadius(f->Farm::get_x(), f->Farm::get_y(),
-																										center_x, center_y, radius,
-																										radiusSquared);
-		if (premisesDistance >= 0){
-			distancesNeighbors.emplace(premisesDistance, f);
-		}
-	}
-}
-
-/// Adds premises as a neighbor with temporary distance of -1 (calculated later if needed)
-void Grid_manager::add_premisesWithoutDistance(const std::vector<Farm*>& premisesToAdd,
-	std::multimap<double, Farm*>& distancesNeighbors)
+void Grid_manager::get_neighborsInRadius(const std::vector<Farm*>& focals, const double radius,
+	const double radiusSquared, std::vector<Farm*>& output)
 {
-	for (auto& f:premisesToAdd){
-		distancesNeighbors.emplace(-1,f);
+	std::vector<std::pair<double, Farm*>> distancesNeighbors;
+	for (auto& focal:focals){
+		neighborCache.get(focal, radius, radiusSquared, distancesNeighbors);
 	}
+	Spatial_index::nearestFirst(distancesNeighbors);
+	std::vector<Farm*> neighbors;
+	neighbors.reserve(distancesNeighbors.size());
+	for (auto& dn:distancesNeighbors){neighbors.emplace_back(dn.second);}
+	neighbors.swap(output);
 }
 
-
 /// Returns neighboring cells containing premises in the same state. If
 /// inAnyReportedStates is TRUE, also returns any neighboring cells from states in which
 /// disease has been reported.
@@ -1582,33 +1748,6 @@ void Grid_manager::get_neighborCellsByState(Grid_cell* focalCell, std::string fo
 
 
 
-/// This function should only be called when distances to each premises are needed (i.e.
-/// to prioritize by proximity) and there are unknown distances to fill in, for efficiency
-void Grid_manager::fill_premisesDistances(Farm* focal)
-{
-	double focal_x = focal->Farm::get_x();
-	double focal_y = focal->Farm::get_y();
-	// make a copy of the distances-neighbors multimap (includes some farms without distances)
-	std::multimap<double, Farm*> dn = *(focal->Farm::get_distancesNeighbors());
-	// get range of elements where distance == -1
-	auto itRange = dn.equal_range(-1);
-
-	for (std::multimap<double, Farm*>::iterator it = itRange.first; it!=itRange.second; ++it){
-		Farm* neighborPrem = it->second;
-		double neighbor_x = neighborPrem->Farm::get_x();
-		double neighbor_y = neighborPrem->Farm::get_y();
-		double xdiff = focal_x - neighbor_x;
-		double ydiff = focal_y - neighbor_y;
-		double distSquared = xdiff*xdiff + ydiff*ydiff;
-		dn.emplace(distSquared, neighborPrem); // add new distance calculation
-	}
-	// remove previous versions of elements without distance
-	dn.erase(itRange.first, itRange.second);
-	// assign modified multimap to Farm object
-	focal->Farm::set_distancesNeighbors(dn);
-}
-
-
 /// Finds cell containing a point (i.e. landfill) with x and y coordinates and FIPS code.
 /// If x, y, and FIPS code don't align, will return -1. If FIPS code not defined from
 /// premises list, will return -1. Could potentially add code in the future to assign
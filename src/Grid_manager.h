@@ -3,12 +3,14 @@
 
 #include "File_manager.h" // for parameter struct
 #include "Grid_cell.h"
+#include "Kernel_matrix.h"
 #include "shared_functions.h" //random_unique
+#include "Neighbor_cache.h"
+#include "Spatial_index.h"
 #include "USAMM_parameters.h"
 
 #include <algorithm> // std::sort, std::any_of, std::find
-#include <map> // std::multimap
-#include <stack>
+#include <map>
 #include <tuple>
 #include <unordered_map>
 #include <utility> // std::pair
@@ -28,6 +30,13 @@ class Grid_manager
 		const Parameters* parameters;
 		// variables for grid creation
 		unsigned int maxFarms; ///< Threshold number of premises per cell (cell size takes precedence)
+		/// A square of the density-based grid with the premises within it, as a range of
+		/// positions in the list being partitioned
+		struct Quad_node
+		{
+			double x, y, s; ///< Lower left corner and side
+			size_t begin, end; ///< Positions of the premises in this square
+		};
 		bool shipments_on; ///Keeps track of if shipments are turned on.
 
 		std::string shipment_kernel_str; ///Stores the shipment kernel type.
@@ -35,7 +44,7 @@ class Grid_manager
 			allCells; ///< Unordered_map of all cells in grid
 		std::unordered_map<int, Farm*>
 			farm_map; ///< Unordered_map of all premises objects
-        std::vector<Farm*> farm_vector; ///<Vector containing pointers to all premises objects.
+        std::vector<Farm*> farm_vector; ///<Vector containing pointers to all premises objects, in file order, so indexed by Farm::get_ordinal.
 		std::unordered_map<std::string, State*>
             state_map; //Contains states, name as key.
         std::vector<State*> state_vector;
@@ -46,6 +55,8 @@ class Grid_manager
 		std::unordered_map<std::string,
         std::unordered_map< std::string, std::vector<Farm*> >> fipsSpeciesMap;
 			// key is fips code, then species name, then sorted by population size
+		Kernel_matrix cellKernel; ///< Cell-to-cell max susceptibility * kernel values, indexed by cell ID
+		std::string tunedGrid; ///< Grid parameters chosen automatically (config 40), for the run log
 		std::unordered_map<std::string, std::vector<Grid_cell*>> cellsByCounty;
  		std::vector<Farm*>
  			farmList; // vector of pointers to all farms (deleted in chunks as grid is created)
@@ -63,6 +74,8 @@ class Grid_manager
 		std::unordered_map<std::string,double> normSus; ///< Normalized species-specific susceptibility values, in same order as speciesOnAllFarms
 		Local_spread* kernel;
 
+		Spatial_index premisesIndex; ///< All premises sorted into buckets, for finding premises within control radii
+		Neighbor_cache neighborCache; ///< Premises within control radii of focal premises, shared by replicates
 		unsigned int committedFarms; ///< Used to double-check that all loaded premises were committed to a cell
 		int printCellFile;
 		std::string batch; ///< Cells printed to file with name: [batch]_cells.txt
@@ -99,17 +112,17 @@ class Grid_manager
 		std::vector<Farm*> getFarms(
 			std::tuple<int,double,double,double>& cellSpecs,
 			const unsigned int maxFarms=0); ///< Makes list of farms in a cell (quits early if over max)
-		void removeParent(
-			std::stack< std::tuple<int,double,double,double> >& queue);///< Removes 1st item in queue
-		void addOffspring(
-			std::tuple<int,double,double,double> cellSpecs,
-			std::stack< std::tuple<int,double,double,double> >& queue);
+		///> Splits a square into quadrants until each has fewer than maxPrems premises or is smaller than minCutoff
+		void splitQuadrants(std::vector<Farm*>& prems, const Quad_node& node, const unsigned int maxPrems,
+			const int minCutoff, int depth, const int stopDepth, std::vector<Quad_node>& output);
+		///> Finds the cells of a grid by density, in the order they are numbered
+		void densityCells(const unsigned int maxPrems, const int minCutoff, std::vector<Farm*>& prems,
+			std::vector<Quad_node>& cells);
+		///> Predicted local spread cost per infectious premises per timestep for a grid by density
+		double predictedCost(const std::vector<Farm*>& prems, const std::vector<Quad_node>& cells);
 		void commitCell(
 			std::tuple<int,double,double,double> cellSpecs,
 			std::vector<Farm*>& farmsInCell); ///< Adds Grid_cell to allCells
-		void splitCell(
-			std::tuple<int,double,double,double>& cellSpecs,
-			std::stack< std::tuple<int,double,double,double> >& queue); ///< Replaces parent cell with subdivided offspring quadrants
  		void assignCellIDtoFarms(int cellID, std::vector<Farm*>& farmsInCell);
  		void removeFarmSubset(std::vector<Farm*>&, std::vector<Farm*>&); ///< Remove farms in first vector from second vector
 
@@ -118,20 +131,11 @@ class Grid_manager
 		void read_seedSource(std::string, std::vector<std::vector<int>>&); ///< Reads seed file with multiple premises IDs per line
 		void select_randomPremisesPerCounty(std::vector<std::vector<Farm*>>&); ///< Selects seed premises from all counties
 		void select_randomPremisesPerCounty(std::vector<std::string>, std::vector<std::vector<Farm*>>&); ///< Selects seed premises from specified counties
-		double pointDistanceWithinRadius(const double, const double, const double, const double, const double, const double); ///< Returns distance of x and y coordinates from center point IF within radius (if not, returns -1)
-		unsigned int pointWithinRadius(const double, const double, const double, const double, const double, const double); ///< Boolean wrapper function for pointDistanceWithinRadius (used for checking cell corners, where distance need not be recorded), returns 1 if within radius, 0 if not
-		unsigned int count_cellCornersWithinRadius(Grid_cell*, const double, const double, const double, const double); ///< Evaluates number of corners of grid cell within radius, returns 0-4
-		void calc_neighborsInRadius(Farm*, const double, const double, bool, std::multimap<double, Farm*>&); ///< Retrieves premises within radius from focal premises
-		void get_neighborCellsToCheck(Grid_cell*, std::vector<Grid_cell*>&); ///< Adds neighboring cells to vector of cells to check
-		void add_premisesInRadius(const double, const double, const double, const double,
-			const std::vector<Farm*>&, std::multimap<double, Farm*>&); ///< From vector of premises to check, adds premises that are within radius to multimap of neighbors
-		void add_premisesWithoutDistance(const std::vector<Farm*>&,
-			std::multimap<double, Farm*>&); ///< Adds premises as neighbors without specifying distance
-		void fill_premisesDistances(Farm*); ///< Fill in missing distances to other premises
 
 		// functions for infection evaluation
 		double shortestCellDist2(Grid_cell*, Grid_cell*); ///< Calculates (shortest distance between two cells)^2
 		void makeCellRefs(); ///< Calculates and stores kernel values and other pre-processing tasks
+		unsigned long long gridCacheKey(); ///< Hash of the premises, grid and kernel inputs that a cached grid depends on
 		// functions for infection evaluation
 		void set_FarmSus(Farm*); ///< Calculates premises susceptibility and stores in Farm
 		void set_FarmInf(Farm*); ///< Calculates premises infectiousness and stores in Farm
@@ -147,6 +151,9 @@ class Grid_manager
 			const unsigned int,
 			const int);
 
+		// 1st way, with maximum farms per cell and min size chosen to minimize predicted cost (config 40)
+		void initiateGrid();
+
 		// 2nd way to initiate a grid: specify file containing cell specs
 		void initiateGrid(
 			std::string &cname);
@@ -155,6 +162,11 @@ class Grid_manager
 		void initiateGrid(
 			double cellSide);
 
+		// Alternative to the above: load grid cells, neighbors and kernel values saved by an earlier run
+		bool loadGridCache(); ///< Loads grid from the cache file (config 39), returns false if there is none or it was built from different inputs
+		void saveGridCache(); ///< Writes grid to the cache file (config 39)
+		const std::string& get_tunedGrid() const; //inlined
+
 		const std::unordered_map<int, Grid_cell*>*
 			get_allCells() const; //inlined
 
@@ -175,8 +187,8 @@ class Grid_manager
 		void get_seedPremises(std::vector<std::vector<Farm*>>&);
 
 		void printCells();
-		void get_neighborsInRadius(Farm*, const double, const double, const bool,
-			std::multimap<double, Farm*>&); ///< Return neighboring premises within radius
+		void get_neighborsInRadius(const std::vector<Farm*>&, const double, const double,
+			std::vector<Farm*>&); ///< Return premises within radius of any focal premises, closest first
 		void get_neighborCellsByState(Grid_cell*, std::string,
 			std::vector<std::string>&, bool, std::vector<Grid_cell*>&);
 		int get_parentCell(double, double, std::string);
@@ -223,6 +235,14 @@ inline void Grid_manager::set_maxFarms(unsigned int in_maxFarms)
 	maxFarms = in_maxFarms;
 }
 
+/// Max premises per cell, min side, number of cells and predicted cost of the grid chosen
+/// automatically (config 40), comma-separated. The cost is "fallback" if every grid tried
+/// had too many cells, and all is "*" if parameters weren't chosen automatically.
+inline const std::string& Grid_manager::get_tunedGrid() const
+{
+	return tunedGrid;
+}
+
 inline const std::unordered_map<int, Grid_cell*>*
 	Grid_manager::get_allCells() const
 {
@@ -0,0 +1,106 @@
+#include "Kernel_matrix.h"
+#include <utility> // std::pair
+#include "shared_functions.h" // writeBinary, readBinary
+
+Kernel_matrix::Kernel_matrix()
+	:
+	n(0),
+	stride(0),
+	dense(true)
+{
+	rowStart.assign(1, 0);
+}
+
+Kernel_matrix::~Kernel_matrix()
+{
+}
+
+/// Entries are counted and placed by row, then each row is sorted by cell ID, so only
+/// the non-zero values are ever stored.
+/// \param[in] nCells Number of cells
+/// \param[in,out] entries Non-zero values, in any number of parts (e.g. one per thread), emptied as they are used
+void Kernel_matrix::build(size_t nCells, std::vector<std::vector<Entry>>& entries)
+{
+	n = nCells;
+	stride = n;
+	rowStart.assign(n+1, 0);
+	for (auto& part:entries){
+		for (auto& e:part){++rowStart[e.from+1];}
+	}
+	for (size_t from = 0; from < n; from++){rowStart[from+1] += rowStart[from];}
+	size_t nonZero = rowStart[n];
+
+	std::vector<int> newReachable(nonZero);
+	std::vector<double> csrValues(nonZero);
+	std::vector<size_t> nextInRow(rowStart.begin(), rowStart.end()-1);
+	for (auto& part:entries){
+		for (auto& e:part){
+			size_t k = nextInRow[e.from]++;
+			newReachable[k] = e.to;
+			csrValues[k] = e.value;
+		}
+		std::vector<Entry>().swap(part);
+	}
+	std::vector<std::pair<int, double>> row;
+	for (size_t from = 0; from < n; from++){
+		row.clear();
+		for (size_t k = rowStart[from]; k < rowStart[from+1]; k++){
+			row.emplace_back(newReachable[k], csrValues[k]);
+		}
+		std::sort(row.begin(), row.end());
+		for (size_t k = rowStart[from], i = 0; k < rowStart[from+1]; k++, i++){
+			newReachable[k] = row[i].first;
+			csrValues[k] = row[i].second;
+		}
+	}
+	reachable.swap(newReachable);
+
+	// CSR takes a value and an ID per non-zero pair, keep it if it saves at least half the memory
+	if (nonZero*(sizeof(double)+sizeof(int)) < n*stride*sizeof(double)/2){
+		values.swap(csrValues);
+		dense = false;
+	} else {
+		values.assign(n*stride, 0.0);
+		for (size_t from = 0; from < n; from++){
+			for (size_t k = rowStart[from]; k < rowStart[from+1]; k++){
+				values[from*stride + reachable[k]] = csrValues[k];
+			}
+		}
+		dense = true;
+	}
+}
+
+size_t Kernel_matrix::get_memoryBytes() const
+{
+	return values.size()*sizeof(double) + reachable.size()*sizeof(int) +
+		rowStart.size()*sizeof(size_t);
+}
+
+void Kernel_matrix::write(std::ostream& out) const
+{
+	writeBinary(out, (unsigned long long)n);
+	writeBinary(out, (unsigned long long)stride);
+	writeBinary(out, (char)dense);
+	writeBinaryVec(out, values);
+	writeBinaryVec(out, rowStart);
+	writeBinaryVec(out, reachable);
+}
+
+bool Kernel_matrix::read(std::istream& in)
+{
+	unsigned long long inN = 0, inStride = 0;
+	char inDense = 1;
+	if (!readBinary(in, inN) || !readBinary(in, inStride) || !readBinary(in, inDense) ||
+		!readBinaryVec(in, values) || !readBinaryVec(in, rowStart) || !readBinaryVec(in, reachable)){
+		return false;
+	}
+	n = inN;
+	stride = inStride;
+	dense = inDense;
+	// check lengths are consistent so lookups stay in range
+	if (rowStart.size() != n+1 || rowStart[n] != reachable.size() ||
+		(dense && values.size() != n*stride) || (!dense && values.size() != reachable.size())){
+		return false;
+	}
+	return true;
+}
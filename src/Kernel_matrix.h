@@ -0,0 +1,85 @@
+#ifndef Kernel_matrix_h
+#define Kernel_matrix_h
+
+#include <algorithm> // std::lower_bound, std::sort
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/// Pre-calculated cell-to-cell values of (maximum susceptibility * kernel), indexed by
+/// cell ID (IDs must run from 0 to n-1). build() takes only the non-zero values and
+/// records, for each cell, the cells it can reach (in ID order) as compressed sparse rows
+/// (CSR). The values are kept in CSR form unless a dense row-major matrix would take less
+/// than twice the memory, in which case they are expanded for faster lookups.
+class Kernel_matrix
+{
+	private:
+		size_t n; ///< Number of cells
+		size_t stride; ///< Length of each row of the dense matrix
+		bool dense; ///< True if values are stored as a dense matrix, false if CSR
+		std::vector<double> values; ///< Dense: n*stride values. CSR: non-zero values, in the same order as reachable
+		std::vector<size_t> rowStart; ///< Start of each cell's row in reachable (and CSR values), n+1 elements
+		std::vector<int> reachable; ///< IDs of cells with non-zero values, grouped by row
+
+	public:
+		/// One non-zero value, from cell ID to cell ID
+		struct Entry
+		{
+			int from;
+			int to;
+			double value;
+		};
+
+		Kernel_matrix();
+		~Kernel_matrix();
+
+		///> Builds rows for nCells cells from non-zero entries in any order, emptying entries
+		void build(size_t nCells, std::vector<std::vector<Entry>>& entries);
+
+		double at(int from, int to) const; //inlined
+		const int* reachable_begin(int from) const; //inlined
+		const int* reachable_end(int from) const; //inlined
+		size_t get_n_reachable(int from) const; //inlined
+		size_t get_n() const; //inlined
+		bool is_dense() const; //inlined
+		size_t get_memoryBytes() const; ///< Approximate memory used by stored values and lists
+		void write(std::ostream&) const; ///< Writes the matrix to a binary stream (grid cache)
+		bool read(std::istream&); ///< Reads a matrix written by write(), returns false if incomplete
+};
+
+inline double Kernel_matrix::at(int from, int to) const
+{
+	if (dense){return values[from*stride + to];}
+	const int* rowBegin = reachable_begin(from);
+	const int* rowEnd = reachable_end(from);
+	const int* match = std::lower_bound(rowBegin, rowEnd, to);
+	if (match == rowEnd || *match != to){return 0;}
+	return values[match - reachable.data()];
+}
+
+inline const int* Kernel_matrix::reachable_begin(int from) const
+{
+	return reachable.data() + rowStart[from];
+}
+
+inline const int* Kernel_matrix::reachable_end(int from) const
+{
+	return reachable.data() + rowStart[from+1];
+}
+
+inline size_t Kernel_matrix::get_n_reachable(int from) const
+{
+	return rowStart[from+1] - rowStart[from];
+}
+
+inline size_t Kernel_matrix::get_n() const
+{
+	return n;
+}
+
+inline bool Kernel_matrix::is_dense() const
+{
+	return dense;
+}
+
+#endif // Kernel_matrix_h
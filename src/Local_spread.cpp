@@ -7,7 +7,11 @@
 Local_spread::Local_spread(int kernelType, std::vector<double> kparams)
 	:
 	kType(kernelType),
-	kp(kparams)
+	kp(kparams),
+	tableMinDistSq(0),
+	tableMaxDistSq(0),
+	tableShift(0),
+	tableFirstKey(0)
 {
 	verbose = verboseLevel;
 	switch (kType)
@@ -33,7 +37,11 @@ Local_spread::Local_spread(int kernelType, std::vector<double> kparams)
 Local_spread::Local_spread(int kernelType, std::string fname)
 	:
 	kType(kernelType),
-	datafile(fname)
+	datafile(fname),
+	tableMinDistSq(0),
+	tableMaxDistSq(0),
+	tableShift(0),
+	tableFirstKey(0)
 {	
 	verbose = verboseLevel;
 	switch (kType)
@@ -89,7 +97,7 @@ Local_spread::~Local_spread()
 /// points(usedist, (k1 / (1 + (usq^(k3/2))/(k2^k3))),col="blue",pch="*")
 /// \endcode
 
-double Local_spread::atDistSq(double distSq)
+double Local_spread::exactAtDistSq(double distSq)
 {
 	double k;
 	switch (kType)
@@ -128,3 +136,215 @@ if(verbose>1){std::cout << "Matched distance "<<std::sqrt(distSq)<<" with probab
 	}
  return std::min(1.0,k);
 }
+
+/// Same values as the single-distance version. Without a lookup table, the kernel type
+/// and parameters are looked up once for all distances.
+void Local_spread::atDistSq(const double* distSq, double* out, size_t n)
+{
+	if (!table.empty()){
+		for (size_t i = 0; i < n; i++){out[i] = atDistSq(distSq[i]);}
+		return;
+	}
+	switch (kType)
+	{
+		case 0:{ // power law function
+			double k0 = kp.at(0), k3 = kp.at(3), k4 = kp.at(4);
+			for (size_t i = 0; i < n; i++){
+				out[i] = std::min(1.0, k0/(1+pow(distSq[i],k3)/k4));
+			}
+			break;
+		}
+		case 1:{ // UK data-based levels, matched one at a time
+			for (size_t i = 0; i < n; i++){out[i] = exactAtDistSq(distSq[i]);}
+			break;
+		}
+		case 2:{ // "kernel4"
+			double k0 = kp.at(0), k1 = kp.at(1), k2 = kp.at(2);
+			for (size_t i = 0; i < n; i++){
+				double dOverK2 = std::sqrt(distSq[i])/k1;
+				out[i] = std::min(1.0, k0/pow((1+dOverK2),k2));
+			}
+			break;
+		}
+		default:{
+			std::cout << "Unrecognized kernel type. Exiting..." << std::endl; Rcpp::stop("");
+		}
+	}
+}
+
+/// \param[in] maxDistSq	Distance squared covered by the table (e.g. across all premises)
+/// \param[in] maxRelError	Largest relative error allowed for table values (0 for no table)
+///
+/// The table ends where the kernel becomes negligible (see effectiveMaxDistSq) if that is
+/// before maxDistSq, and starts tableOctaves octaves of distance squared below its end.
+/// Each octave is split into the same number of bins, so bins are narrow at short
+/// distances where the kernel changes fastest and most transmission happens, and a lookup
+/// only takes a shift of distSq's bits and a table load. Values within a bin are
+/// interpolated linearly. Bins where interpolation would exceed maxRelError (e.g. steps
+/// between levels for kernel type 1) are marked to be evaluated exactly, as are distances
+/// outside the table. The bins per octave are doubled until few bins need exact
+/// evaluation. Interpolated values always lie between the exact values at the ends of the
+/// bin, so a decreasing kernel stays decreasing and the maximum kernel value between two
+/// cells is still at their shortest distance.
+void Local_spread::makeTable(double maxDistSq, double maxRelError)
+{
+	table.clear();
+	tableMinDistSq = 0;
+	tableMaxDistSq = 0;
+	if (maxRelError <= 0 || maxDistSq <= 0){return;}
+	int savedVerbose = verbose;
+	verbose = 0; // no output for each of the many exact evaluations
+	tableMaxDistSq = effectiveMaxDistSq(maxDistSq);
+	tableMinDistSq = std::ldexp(1.0, std::ilogb(tableMaxDistSq) - tableOctaves);
+	double requestedMaxDistSq = tableMaxDistSq;
+	size_t maxBins = 1<<20; // 16 MB
+	int binsPerOctaveBits = 4;
+	size_t nExact = fillTable(binsPerOctaveBits, maxRelError);
+	while (nExact > table.size()/100 && 2*table.size() <= maxBins){
+		tableMaxDistSq = requestedMaxDistSq;
+		nExact = fillTable(++binsPerOctaveBits, maxRelError);
+	}
+if (verboseLevel>0){ // set from config by now, unlike verbose
+	std::cout << "Kernel lookup table: " << table.size() << " bins (" << (1<<binsPerOctaveBits) <<
+		" per octave of distance squared) from " << std::sqrt(tableMinDistSq) << " to " <<
+		std::sqrt(tableMaxDistSq)/1000 << " km, " << nExact <<
+		" evaluated exactly to stay within relative error " << maxRelError << std::endl;
+	reportTableAccuracy();
+}
+	verbose = savedVerbose;
+}
+
+/// The kernel is negligible where it falls below negligibleRatio times its value at
+/// distance 0 (found by doubling distance squared, as kernel types 0 and 2 decrease with
+/// distance), or beyond the last level for kernel type 1.
+double Local_spread::effectiveMaxDistSq(double maxDistSq)
+{
+	if (kType == 1){
+		if (distProb.empty()){return maxDistSq;}
+		return std::min(maxDistSq, distProb.rbegin()->first);
+	}
+	double negligible = exactAtDistSq(0)*negligibleRatio;
+	double distSq = 1;
+	while (distSq < maxDistSq && exactAtDistSq(distSq) >= negligible){distSq *= 2;}
+	return std::min(maxDistSq, distSq);
+}
+
+/// Sets the bin layout from tableMinDistSq and tableMaxDistSq (rounded up to the end of a
+/// bin), then fills the bins
+size_t Local_spread::fillTable(int binsPerOctaveBits, double maxRelError)
+{
+	tableShift = 52 - binsPerOctaveBits; // 52 mantissa bits in a double
+	unsigned long long bits;
+	std::memcpy(&bits, &tableMinDistSq, sizeof(bits));
+	tableFirstKey = bits >> tableShift;
+	std::memcpy(&bits, &tableMaxDistSq, sizeof(bits));
+	unsigned long long endKey = (bits >> tableShift) + 1;
+	size_t nBins = endKey - tableFirstKey;
+	bits = endKey << tableShift;
+	std::memcpy(&tableMaxDistSq, &bits, sizeof(tableMaxDistSq));
+	table.assign(nBins, Table_bin());
+
+	// distances squared where data-based levels change: halfway between levels and after the last
+	std::vector<double> steps;
+	if (kType == 1){
+		for (auto it = distProb.begin(); it != distProb.end(); ++it){
+			auto next = std::next(it);
+			if (next != distProb.end()){steps.emplace_back((it->first + next->first)/2);}
+		}
+		if (!distProb.empty()){steps.emplace_back(distProb.rbegin()->first);}
+	}
+	auto stepIt = steps.begin();
+
+	size_t nExact = 0;
+	double start = exactAtDistSq(tableMinDistSq);
+	for (size_t whichBin = 0; whichBin < nBins; whichBin++){
+		double binStart, binEnd;
+		bits = (tableFirstKey + whichBin) << tableShift;
+		std::memcpy(&binStart, &bits, sizeof(binStart));
+		bits = (tableFirstKey + whichBin + 1) << tableShift;
+		std::memcpy(&binEnd, &bits, sizeof(binEnd));
+		double binWidth = binEnd - binStart;
+		double end = exactAtDistSq(binEnd);
+		Table_bin& b = table[whichBin];
+		b.value = start;
+		b.slope = (end - start)/binWidth;
+		bool exact = false;
+		if (kType == 1){
+			// levels are constant between steps, so only bins containing a step need exact matching
+			while (stepIt != steps.end() && *stepIt < binStart){++stepIt;}
+			exact = (start != end) || (stepIt != steps.end() && *stepIt <= binEnd);
+		} else {
+			for (double frac = 0.25; frac < 1; frac += 0.25){
+				double k = exactAtDistSq(binStart + frac*binWidth);
+				double interpolated = b.value + b.slope*frac*binWidth;
+				double error = std::abs(interpolated - k);
+				if (k > 0){error /= k;}
+				if (error > maxRelError){exact = true;}
+			}
+		}
+		if (exact){
+			b.value = -1;
+			++nExact;
+		}
+		start = end;
+	}
+	return nExact;
+}
+
+/// Compares table values with exact values at distances spread evenly in distance and in
+/// distance squared (the first weights the short distances where most transmission happens).
+void Local_spread::reportTableAccuracy()
+{
+	size_t nPoints = 100000;
+	double maxError = 0;
+	double sumError = 0;
+	size_t nFromTable = 0;
+	double maxDist = std::sqrt(tableMaxDistSq);
+	for (size_t i = 0; i < 2*nPoints; i++){
+		double distSq;
+		if (i < nPoints){
+			double d = maxDist*(i+0.5)/nPoints;
+			distSq = d*d;
+		} else {
+			distSq = tableMaxDistSq*(i-nPoints+0.5)/nPoints;
+		}
+		double k = exactAtDistSq(distSq);
+		double error = std::abs(atDistSq(distSq) - k);
+		if (k > 0){error /= k;}
+		maxError = std::max(maxError, error);
+		sumError += error;
+		nFromTable += fromTable(distSq);
+	}
+	std::cout << "Kernel lookup table accuracy over " << 2*nPoints << " distances: maximum relative error " <<
+		maxError << ", mean " << sumError/(2*nPoints) << ", " << 100.0*nFromTable/(2*nPoints) <<
+		"% from the table" << std::endl;
+}
+
+/// Used by tests (tests/testthat/test-kernel_table.R) to check the lookup table of an
+/// equation-based kernel: the fraction of distances answered from the table and the largest
+/// relative error of their values.
+/// \param[in] kernelType	0 or 2 (see Local_spread constructor)
+/// \param[in] kernelParams	Kernel parameters
+/// \param[in] maxDist	Distance covered by the table (e.g. across all premises)
+/// \param[in] maxRelError	Relative error allowed for table values
+/// \param[in] distances	Distances at which to look up the kernel
+// [[Rcpp::export(.kernel_table_coverage)]]
+Rcpp::List kernel_table_coverage(int kernelType, std::vector<double> kernelParams, double maxDist,
+	double maxRelError, std::vector<double> distances)
+{
+	Local_spread exact(kernelType, kernelParams);
+	Local_spread tabled(kernelType, kernelParams);
+	tabled.makeTable(maxDist*maxDist, maxRelError);
+	size_t nFromTable = 0;
+	double maxError = 0;
+	for (auto& d:distances){
+		double distSq = d*d;
+		nFromTable += tabled.fromTable(distSq);
+		double k = exact.atDistSq(distSq);
+		double error = std::abs(tabled.atDistSq(distSq) - k);
+		if (k > 0){error /= k;}
+		maxError = std::max(maxError, error);
+	}
+	double fraction = distances.empty() ? 0 : double(nFromTable)/distances.size();
+	return Rcpp::List::create(Rcpp::Named("fromTable") = fraction, Rcpp::Named("maxRelError") = maxError);
+}
@@ -1,8 +1,10 @@
 #ifndef Local_spread_h
 #define Local_spread_h
 
+#include <cstring> // std::memcpy
 #include <iterator> // std::prev
 #include <map>
+#include <vector>
 #include "shared_functions.h" // for split; contains cmath, fstream, iostream
 
 extern int verboseLevel;
@@ -19,8 +21,30 @@ class Local_spread
 		std::vector<double> kp; ///< Kernel parameters
 		std::string datafile; ///< File containing distances and associated probabilities
 		std::map<double,double> distProb; ///< Map with key of distance (m) squared, value is probability	
+
+		/// One bin of the lookup table: kernel value at the start of the bin and its change
+		/// per unit of distance squared. A negative value marks bins that are evaluated exactly.
+		struct Table_bin
+		{
+			double value;
+			double slope;
+		};
+		std::vector<Table_bin> table; ///< Kernel values in bins of distance squared (empty if not used)
+		double tableMinDistSq; ///< Distance squared at the start of the table (a power of 2), below which the kernel is evaluated exactly
+		double tableMaxDistSq; ///< Distance squared at the end of the table, beyond which the kernel is evaluated exactly
+		int tableShift; ///< Bits dropped from a distance squared (as a double) to give its bin key
+		unsigned long long tableFirstKey; ///< Key of the first bin
+
+		double exactAtDistSq(double); ///< Calculates or matches kernel value without the lookup table
+		double effectiveMaxDistSq(double maxDistSq); ///< Distance squared (up to maxDistSq) beyond which the kernel is negligible
+		size_t fillTable(int binsPerOctaveBits, double maxRelError); ///< Fills table with 2^binsPerOctaveBits bins per octave, returns the number evaluated exactly
+		bool findBin(double distSq, size_t& whichBin, double& binStart) const; //inlined - false if distSq is evaluated exactly
+		void reportTableAccuracy(); ///< Prints the error of table values against the exact kernel
 		
 	public:
+		static constexpr double negligibleRatio = 1e-9; ///< Kernel values below this fraction of the value at distance 0 are beyond the table
+		static constexpr int tableOctaves = 40; ///< Octaves of distance squared covered by the table, below its end
+
 		///> Constructs a kernel from an equation (determined by variable kType)
 		Local_spread(int kernelType, 
 			std::vector<double> kparams = std::vector<double>());
@@ -29,7 +53,47 @@ class Local_spread
 			std::string fname);
 		~Local_spread();
 		///> Calculates or matches kernel value according to form defined at construction
-		double atDistSq(double);
+		double atDistSq(double); //inlined
+		///> Calculates kernel values for n squared distances at once
+		void atDistSq(const double* distSq, double* out, size_t n);
+		///> Replaces evaluation up to maxDistSq with table lookups within maxRelError
+		void makeTable(double maxDistSq, double maxRelError);
+		bool fromTable(double distSq) const; //inlined - true if atDistSq(distSq) is answered by the lookup table
 };
-	
+
+/// Bins are equal divisions of each octave of distance squared, so a bin's key is the
+/// exponent and leading mantissa bits of distSq (as an IEEE double), and its start is the
+/// key with the remaining bits cleared.
+inline bool Local_spread::findBin(double distSq, size_t& whichBin, double& binStart) const
+{
+	if (!(distSq >= tableMinDistSq && distSq < tableMaxDistSq)){return false;}
+	unsigned long long bits;
+	std::memcpy(&bits, &distSq, sizeof(bits));
+	unsigned long long key = bits >> tableShift;
+	whichBin = key - tableFirstKey;
+	if (table[whichBin].value < 0){return false;}
+	bits = key << tableShift;
+	std::memcpy(&binStart, &bits, sizeof(binStart));
+	return true;
+}
+
+/// Uses the lookup table if one was made and distSq is within it
+inline double Local_spread::atDistSq(double distSq)
+{
+	size_t whichBin;
+	double binStart;
+	if (findBin(distSq, whichBin, binStart)){
+		const Table_bin& b = table[whichBin];
+		return b.value + b.slope*(distSq - binStart);
+	}
+	return exactAtDistSq(distSq);
+}
+
+inline bool Local_spread::fromTable(double distSq) const
+{
+	size_t whichBin;
+	double binStart;
+	return findBin(distSq, whichBin, binStart);
+}
+
 #endif // Local_spread_h
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <algorithm> // std::sort, std::upper_bound
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include "Neighbor_cache.h"
+#include "Farm.h"
+
+Neighbor_cache::Neighbor_cache()
+	:
+	index(nullptr),
+	budgetBytes(0),
+	usedBytes(0),
+	precomputedBytes(0)
+{
+	verbose = verboseLevel;
+}
+
+Neighbor_cache::~Neighbor_cache()
+{
+}
+
+void Neighbor_cache::set_index(const Spatial_index* in_index)
+{
+	index = in_index;
+}
+
+void Neighbor_cache::set_budget(double megabytes)
+{
+	budgetBytes = size_t(megabytes*1024*1024);
+}
+
+/// Premises are split into blocks that threads take in turn; each block's lists are kept
+/// separately and joined in premises order afterwards, so the result does not depend on
+/// the number of threads. Stops early (keeping nothing for that radius or larger ones) if
+/// the lists would use more than the memory budget.
+/// \param[in] premises All premises (rows are in this order)
+/// \param[in] radii Radii of ring control rules
+/// \param[in] nThreads Number of threads to use
+void Neighbor_cache::precompute(const std::vector<Farm*>& premises, std::vector<double> radii,
+	unsigned int nThreads)
+{
+	precomputed.clear();
+	rowOf.clear();
+	precomputedBytes = 0;
+	if (index == nullptr || index->empty() || radii.empty()){return;}
+	std::sort(radii.begin(), radii.end());
+	radii.erase(std::unique(radii.begin(), radii.end()), radii.end());
+	for (size_t i = 0; i < premises.size(); i++){
+		size_t ordinal = premises[i]->Farm::get_ordinal();
+		if (ordinal >= rowOf.size()){rowOf.resize(ordinal+1);}
+		rowOf[ordinal] = i;
+	}
+	size_t rowBytes = rowOf.size()*sizeof(size_t);
+	if (nThreads == 0){nThreads = 1;}
+
+	const size_t blockSize = 1024;
+	size_t nBlocks = (premises.size() + blockSize - 1)/blockSize;
+	for (auto& r:radii){
+		Radius_lists lists;
+		lists.radius = r;
+		lists.radiusSquared = r*r;
+		std::vector<std::vector<Neighbor>> blockNeighbors(nBlocks);
+		std::vector<std::vector<size_t>> blockCounts(nBlocks);
+		std::atomic<size_t> nextBlock(0);
+		std::atomic<size_t> totalBytes(precomputedBytes + rowBytes);
+		std::atomic<bool> overBudget(false);
+		auto fillBlocks = [&](){
+			std::vector<Neighbor> oneList;
+			for (size_t b = nextBlock++; b < nBlocks && !overBudget; b = nextBlock++){
+				size_t last = std::min(premises.size(), (b+1)*blockSize);
+				for (size_t i = b*blockSize; i < last; i++){
+					oneList.clear();
+					calculate(premises[i], lists.radius, lists.radiusSquared, oneList);
+					blockCounts[b].emplace_back(oneList.size());
+					blockNeighbors[b].insert(blockNeighbors[b].end(), oneList.begin(), oneList.end());
+				}
+				size_t blockBytes = blockNeighbors[b].size()*sizeof(Neighbor);
+				if ((totalBytes += blockBytes) > budgetBytes){overBudget = true;}
+			}
+		};
+		if (nThreads == 1){
+			fillBlocks();
+		} else {
+			std::vector<std::thread> workers;
+			for (unsigned int i = 0; i < nThreads; i++){workers.emplace_back(fillBlocks);}
+			for (auto& w:workers){w.join();}
+		}
+		if (overBudget){
+			std::cout << "Warning (config 68): Neighbor lists for control radius " << r <<
+				" and larger exceed the neighbor cache budget, and will be calculated when needed." << std::endl;
+			break;
+		}
+		// join blocks in order
+		size_t nNeighbors = 0;
+		for (auto& bn:blockNeighbors){nNeighbors += bn.size();}
+		lists.neighbors.reserve(nNeighbors);
+		lists.rowStart.reserve(premises.size()+1);
+		lists.rowStart.emplace_back(0);
+		for (size_t b = 0; b < nBlocks; b++){
+			for (auto& count:blockCounts[b]){lists.rowStart.emplace_back(lists.rowStart.back() + count);}
+			lists.neighbors.insert(lists.neighbors.end(), blockNeighbors[b].begin(), blockNeighbors[b].end());
+			std::vector<Neighbor>().swap(blockNeighbors[b]);
+		}
+		precomputedBytes += nNeighbors*sizeof(Neighbor) + lists.rowStart.size()*sizeof(size_t);
+		precomputed.emplace_back(std::move(lists));
+if (verbose>0){std::cout << "Neighbor lists precomputed for " << premises.size() << " premises at radius " <<
+	r << ": " << nNeighbors << " neighbors." << std::endl;}
+	}
+	if (precomputed.empty()){
+		std::vector<size_t>().swap(rowOf);
+	} else {
+		precomputedBytes += rowBytes;
+	}
+}
+
+/// Uses the smallest precomputed radius that covers radius if there is one. Otherwise uses
+/// a cached list for the focal premises (if calculated for at least this radius), or
+/// calculates and caches a new one, dropping least recently used lists if over budget.
+/// \param[in] focal Focal premises
+/// \param[in] radius Radius (in same units as premises coordinates)
+/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
+/// \param[out] output Vector to which (distance squared, premises) are added, closest first
+void Neighbor_cache::get(const Farm* focal, double radius, double radiusSquared,
+	std::vector<std::pair<double, Farm*>>& output)
+{
+	for (auto& lists:precomputed){
+		if (lists.radius >= radius){
+			size_t row = rowOf[focal->Farm::get_ordinal()];
+			const Neighbor* begin = lists.neighbors.data() + lists.rowStart[row];
+			const Neighbor* end = lists.neighbors.data() + lists.rowStart[row+1];
+			appendWithin(begin, end, radiusSquared, output);
+			return;
+		}
+	}
+	if (budgetBytes == 0){
+		std::vector<Neighbor> neighbors;
+		calculate(focal, radius, radiusSquared, neighbors);
+		output.insert(output.end(), neighbors.begin(), neighbors.end());
+		return;
+	}
+
+	int ordinal = focal->Farm::get_ordinal();
+	std::unique_lock<std::mutex> lock(cacheMutex);
+	if (size_t(ordinal) >= cachedSlot.size()){cachedSlot.resize(ordinal+1, 0);}
+	if (cachedSlot[ordinal] != 0 && cached[cachedSlot[ordinal]-1].radius >= radius){
+		Cached_list& c = cached[cachedSlot[ordinal]-1];
+		leastRecent.splice(leastRecent.begin(), leastRecent, c.lruPosition);
+		appendWithin(c.neighbors.data(), c.neighbors.data() + c.neighbors.size(), radiusSquared, output);
+		return;
+	}
+	lock.unlock();
+	// calculate without holding the lock (the index is read-only)
+	Cached_list newList;
+	newList.radius = radius;
+	calculate(focal, radius, radiusSquared, newList.neighbors);
+	newList.neighbors.shrink_to_fit();
+	output.insert(output.end(), newList.neighbors.begin(), newList.neighbors.end());
+	size_t newBytes = bytes(newList);
+	if (precomputedBytes + newBytes > budgetBytes){return;} // too large to keep
+
+	lock.lock();
+	if (cachedSlot[ordinal] != 0){
+		if (cached[cachedSlot[ordinal]-1].radius >= radius){return;} // another replicate stored it meanwhile
+		dropCached(ordinal);
+	}
+	leastRecent.push_front(ordinal);
+	newList.lruPosition = leastRecent.begin();
+	if (freeSlots.empty()){
+		cached.emplace_back(std::move(newList));
+		cachedSlot[ordinal] = cached.size();
+	} else {
+		cached[freeSlots.back()] = std::move(newList);
+		cachedSlot[ordinal] = freeSlots.back()+1;
+		freeSlots.pop_back();
+	}
+	usedBytes += newBytes;
+	while (precomputedBytes + usedBytes > budgetBytes){dropCached(leastRecent.back());}
+}
+
+/// Frees the list's memory and leaves its position in cached for the next new list. Call
+/// with cacheMutex locked.
+/// \param[in] ordinal Ordinal of a premises with a cached list
+void Neighbor_cache::dropCached(int ordinal)
+{
+	size_t slot = cachedSlot[ordinal]-1;
+	usedBytes -= bytes(cached[slot]);
+	leastRecent.erase(cached[slot].lruPosition);
+	std::vector<Neighbor>().swap(cached[slot].neighbors);
+	freeSlots.emplace_back(slot);
+	cachedSlot[ordinal] = 0;
+}
+
+void Neighbor_cache::calculate(const Farm* focal, double radius, double radiusSquared,
+	std::vector<Neighbor>& output) const
+{
+	index->inRadius(focal->Farm::get_x(), focal->Farm::get_y(), radius, radiusSquared, output);
+	std::sort(output.begin(), output.end(),
+		[](const Neighbor& a, const Neighbor& b){return a.first < b.first;});
+}
+
+/// Includes the list's entry in cached and leastRecent
+size_t Neighbor_cache::bytes(const Cached_list& c) const
+{
+	return c.neighbors.capacity()*sizeof(Neighbor) + sizeof(Cached_list) + 3*sizeof(void*);
+}
+
+void Neighbor_cache::appendWithin(const Neighbor* begin, const Neighbor* end, double radiusSquared,
+	std::vector<Neighbor>& output)
+{
+	const Neighbor* last = std::upper_bound(begin, end, radiusSquared,
+		[](double rSq, const Neighbor& n){return rSq < n.first;});
+	output.insert(output.end(), begin, last);
+}
@@ -0,0 +1,78 @@
+#ifndef Neighbor_cache_h
+#define Neighbor_cache_h
+
+#include <list>
+#include <mutex>
+#include <utility> // std::pair
+#include <vector>
+
+#include "Spatial_index.h"
+
+class Farm;
+
+extern int verboseLevel;
+
+/// Stores lists of premises within control radii of focal premises, sorted by distance
+/// squared, within a memory budget. Lists for the radii of ring control rules can be
+/// precomputed for all premises at startup, stored as one flat array per radius with a
+/// start position for each premises (compressed sparse rows); these are read without
+/// locking. Other lists are calculated when first requested and kept until the budget is
+/// exceeded, when the least recently used lists are dropped. Shared by replicates running
+/// in parallel.
+class Neighbor_cache
+{
+	private:
+		typedef std::pair<double, Farm*> Neighbor; ///< Distance squared and neighboring premises
+
+		/// Neighbor lists of all premises for one radius
+		struct Radius_lists
+		{
+			double radius;
+			double radiusSquared;
+			std::vector<size_t> rowStart; ///< Start of each premises' list in neighbors, by row
+			std::vector<Neighbor> neighbors; ///< All lists, each sorted by distance squared
+		};
+
+		/// Neighbor list of one premises, calculated on request
+		struct Cached_list
+		{
+			double radius;
+			std::vector<Neighbor> neighbors; ///< Sorted by distance squared
+			std::list<int>::iterator lruPosition; ///< Position in leastRecent
+		};
+
+		int verbose; ///< Can be set to override global setting for console output
+		const Spatial_index* index; ///< Premises sorted into buckets, used to calculate lists
+		size_t budgetBytes; ///< Memory allowed for precomputed and cached lists
+		size_t usedBytes; ///< Memory used by cached (not precomputed) lists
+		size_t precomputedBytes; ///< Memory used by precomputed lists
+		std::vector<Radius_lists> precomputed; ///< Precomputed lists, in order of radius
+		std::vector<size_t> rowOf; ///< Row of each premises in precomputed lists, by ordinal
+		std::vector<Cached_list> cached; ///< Lists calculated on request (except positions in freeSlots)
+		std::vector<size_t> cachedSlot; ///< Position of each premises' list in cached plus 1 (0 if none), by ordinal
+		std::vector<size_t> freeSlots; ///< Positions in cached not holding a list
+		std::list<int> leastRecent; ///< Ordinals of premises with cached lists, most recently used first
+		std::mutex cacheMutex; ///< Guards cached lists when replicates run in parallel
+
+		void calculate(const Farm* focal, double radius, double radiusSquared,
+			std::vector<Neighbor>& output) const; ///< Finds premises within radius, sorted by distance squared
+		size_t bytes(const Cached_list&) const; ///< Approximate memory used by one cached list
+		void dropCached(int ordinal); ///< Removes the cached list of a premises
+		static void appendWithin(const Neighbor* begin, const Neighbor* end, double radiusSquared,
+			std::vector<Neighbor>& output); ///< Appends neighbors from a sorted list that are within radius
+
+	public:
+		Neighbor_cache();
+		~Neighbor_cache();
+
+		void set_index(const Spatial_index* in_index); ///< Sets the premises index used to calculate lists
+		void set_budget(double megabytes); ///< Sets memory allowed for lists (0 to calculate lists every time)
+		///> Calculates lists for all premises at each radius, unless they would exceed the budget
+		void precompute(const std::vector<Farm*>& premises, std::vector<double> radii,
+			unsigned int nThreads);
+		///> Appends (distance squared, premises) for all premises within radius of focal
+		void get(const Farm* focal, double radius, double radiusSquared,
+			std::vector<std::pair<double, Farm*>>& output);
+};
+
+#endif // Neighbor_cache_h
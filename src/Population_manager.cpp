@@ -39,9 +39,7 @@ Population_manager::~Population_manager()
 
 // set initial farm size for farm f
 void Population_manager::set_initialFarmSize(Farm* f){
-    //get farm id
-    int fid = f->Farm::get_id();
-    Prem_status* prem_status_fid=statusManagerPointer->get_correspondingPremStatus(fid); // creates pointer to prem_status object
+    Prem_status* prem_status_fid=statusManagerPointer->get_correspondingPremStatus(f); // creates pointer to prem_status object
     
     //for the species on the farm
     for (auto& sp:speciesOnPrems){
@@ -53,8 +51,7 @@ void Population_manager::set_initialFarmSize(Farm* f){
 
 //check if there is an current size stored and if there is not, then set one
 void Population_manager::verify_currentSize(Farm* f){
-    int fid = f->Farm::get_id();
-    Prem_status* prem_status_fid=statusManagerPointer->get_correspondingPremStatus(fid); // creates pointer to prem_status object
+    Prem_status* prem_status_fid=statusManagerPointer->get_correspondingPremStatus(f); // creates pointer to prem_status object
 
     int total=0;
     for (auto& sp:speciesOnPrems){
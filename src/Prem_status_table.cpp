@@ -0,0 +1,38 @@
+#include "Prem_status_table.h"
+
+/// \param[in] nPrems Number of premises (one more than the largest ordinal)
+Prem_status_table::Prem_status_table(size_t nPrems)
+	:
+	nUsed(0),
+	byOrdinal(nPrems, nullptr)
+{
+}
+
+Prem_status_table::~Prem_status_table()
+{
+}
+
+Prem_status* Prem_status_table::add(Farm* f)
+{
+	int ordinal = f->Farm::get_ordinal();
+	Prem_status* ps = byOrdinal[ordinal];
+	if (ps != nullptr){return ps;}
+	if (nUsed < pool.size()){
+		ps = &pool[nUsed];
+		ps->Prem_status::reset(f);
+	} else {
+		pool.emplace_back(f);
+		ps = &pool.back();
+	}
+	++nUsed;
+	byOrdinal[ordinal] = ps;
+	touched.emplace_back(ordinal);
+	return ps;
+}
+
+void Prem_status_table::clear()
+{
+	for (auto& ordinal:touched){byOrdinal[ordinal] = nullptr;}
+	touched.clear();
+	nUsed = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef Prem_status_table_h
+#define Prem_status_table_h
+
+#include <deque>
+#include <vector>
+
+#include "Farm.h"
+
+/// Replicate-specific statuses of premises, indexed by premises ordinal. Prem_status
+/// objects are kept in a pool (allocated in blocks by the deque, so they never move) and
+/// reused by later replicates: clear() only empties the entries set since the last clear,
+/// and add() reinitializes a pooled object before allocating a new one. Each thread that
+/// runs replicates has its own table.
+class Prem_status_table
+{
+	private:
+		std::deque<Prem_status> pool; ///< All Prem_status objects made so far, of which the first nUsed are in use
+		size_t nUsed; ///< Number of pooled objects in use this replicate
+		std::vector<Prem_status*> byOrdinal; ///< Status of each premises by ordinal, nullptr if none this replicate
+		std::vector<int> touched; ///< Ordinals of premises with a status this replicate
+
+	public:
+		Prem_status_table(size_t nPrems);
+		~Prem_status_table();
+
+		Prem_status* find(const Farm* f) const; //inlined - nullptr if f has no status
+		Prem_status* add(Farm* f); ///< Returns status of f, making one if f has none yet
+		size_t size() const; //inlined
+		void clear(); ///< Removes all statuses, keeping the objects for reuse
+};
+
+inline Prem_status* Prem_status_table::find(const Farm* f) const
+{
+	return byOrdinal[f->Farm::get_ordinal()];
+}
+
+inline size_t Prem_status_table::size() const
+{
+	return nUsed;
+}
+
+#endif // Prem_status_table_h
@@ -0,0 +1,251 @@
+#include <Rcpp.h>
+
+#include <atomic>
+#include <cctype> // std::isdigit, std::isspace
+#include <climits> // INT_MAX
+#include <cstdlib> // std::strtod
+#include <cstring> // std::memchr
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "Premises_file.h"
+#include "shared_functions.h" // writeBinary, readBinary
+
+const char premisesFileID[8] = {'U','S','D','O','S','P','R','M'}; ///< Identifies binary premises files
+const unsigned int premisesFileVersion = 1; ///< Increase when the binary premises layout changes
+
+namespace
+{
+	/// Reads an integer from a field the same way as stringToNum<int> (-1 if none)
+	int fieldToInt(const char* s, const char* e)
+	{
+		while (s < e && std::isspace((unsigned char)*s)){++s;}
+		bool negative = false;
+		if (s < e && (*s == '-' || *s == '+')){negative = (*s == '-'); ++s;}
+		if (s == e || !std::isdigit((unsigned char)*s)){return -1;}
+		long long value = 0;
+		while (s < e && std::isdigit((unsigned char)*s)){
+			value = value*10 + (*s - '0');
+			if (value > INT_MAX){return -1;}
+			++s;
+		}
+		return negative ? -value : value;
+	}
+
+	/// Reads a double from a field the same way as stringToNum<double> (-1 if none). The
+	/// buffer must be null-terminated after the last field.
+	double fieldToDouble(const char* s, const char* e)
+	{
+		while (s < e && std::isspace((unsigned char)*s)){++s;}
+		if (s == e){return -1;}
+		char* stop;
+		double value = std::strtod(s, &stop);
+		if (stop == s){return -1;}
+		return value;
+	}
+}
+
+void Premises_columns::append(const Premises_columns& more)
+{
+	id.insert(id.end(), more.id.begin(), more.id.end());
+	fips.insert(fips.end(), more.fips.begin(), more.fips.end());
+	coord1.insert(coord1.end(), more.coord1.begin(), more.coord1.end());
+	coord2.insert(coord2.end(), more.coord2.begin(), more.coord2.end());
+	counts.insert(counts.end(), more.counts.begin(), more.counts.end());
+	totals.insert(totals.end(), more.totals.begin(), more.totals.end());
+}
+
+Premises_file::Premises_file(size_t in_nSpecies, unsigned int in_nThreads)
+	:
+	nSpecies(in_nSpecies),
+	nThreads(in_nThreads)
+{
+	verbose = verboseLevel;
+	if (nThreads == 0){nThreads = 1;}
+}
+
+Premises_file::~Premises_file()
+{
+}
+
+void Premises_file::read(const std::string& fname, Premises_columns& output)
+{
+	output = Premises_columns();
+	output.nSpecies = nSpecies;
+	std::ifstream f(fname, std::ios::binary);
+	if (!f){std::cout << "Premises file not found. Exiting..." << std::endl; Rcpp::stop("");}
+	char inID[sizeof(premisesFileID)] = {0};
+	f.read(inID, sizeof(inID));
+	f.close();
+	if (std::equal(inID, inID+sizeof(inID), premisesFileID)){
+		readBinaryFile(fname, output);
+	} else {
+		readTextFile(fname, output);
+	}
+}
+
+void Premises_file::readTextFile(const std::string& fname, Premises_columns& output)
+{
+	std::ifstream f(fname, std::ios::binary);
+	f.seekg(0, f.end);
+	size_t length = f.tellg();
+	f.seekg(0, f.beg);
+	std::vector<char> buffer(length+1);
+	f.read(buffer.data(), length);
+	buffer[length] = '\0'; // stops strtod at the end of the last field
+	f.close();
+if (verbose>0){std::cout << "Premises file open, loading premises." << std::endl;}
+
+	const char* begin = buffer.data();
+	const char* end = begin + length;
+	// skip the Byte Order Mark that defines UTF-8 in some text files
+	if (length >= 3 && (unsigned char)begin[0] == 0xEF && (unsigned char)begin[1] == 0xBB &&
+		(unsigned char)begin[2] == 0xBF){
+		begin += 3;
+	}
+
+	// split into chunks of whole lines, several per thread so uneven chunks even out
+	size_t nChunks = 1;
+	if (nThreads > 1){nChunks = nThreads*4;}
+	std::vector<const char*> chunkStart(1, begin);
+	for (size_t c = 1; c < nChunks; c++){
+		const char* target = begin + (end-begin)*c/nChunks;
+		if (target < chunkStart.back()){target = chunkStart.back();}
+		const char* lineEnd = (const char*)std::memchr(target, '\n', end-target);
+		chunkStart.emplace_back(lineEnd == nullptr ? end : lineEnd+1);
+	}
+	chunkStart.emplace_back(end);
+
+	std::vector<Premises_columns> chunks(nChunks);
+	std::vector<std::string> badLines(nChunks);
+	std::vector<char> chunkOK(nChunks, 1);
+	std::atomic<size_t> nextChunk(0);
+	auto parseChunks = [&](){
+		for (size_t c = nextChunk++; c < nChunks; c = nextChunk++){
+			chunks[c].nSpecies = nSpecies;
+			chunkOK[c] = parseChunk(chunkStart[c], chunkStart[c+1], chunks[c], badLines[c]);
+		}
+	};
+	if (nThreads == 1){
+		parseChunks();
+	} else {
+		std::vector<std::thread> workers;
+		for (unsigned int i = 0; i < nThreads; i++){workers.emplace_back(parseChunks);}
+		for (auto& w:workers){w.join();}
+	}
+
+	for (size_t c = 0; c < nChunks; c++){
+		if (!chunkOK[c]){
+			std::cout<<"ERROR (premises file & config 44-46) at line"<<std::endl;
+			std::cout<< badLines[c] <<std::endl;
+			std::cout<< ": number of columns with animal populations don't match up with list of species provided."<<std::endl;
+			std::cout<<"Exiting..."<<std::endl;
+			Rcpp::stop("");
+		}
+	}
+	size_t nRows = 0;
+	for (auto& c:chunks){nRows += c.size();}
+	output.id.reserve(nRows);
+	output.fips.reserve(nRows);
+	output.coord1.reserve(nRows);
+	output.coord2.reserve(nRows);
+	output.counts.reserve(nRows*nSpecies);
+	output.totals.reserve(nRows);
+	for (auto& c:chunks){output.append(c);}
+}
+
+/// Fields are separated by tabs, and empty fields are skipped (as in split()).
+bool Premises_file::parseChunk(const char* begin, const char* end, Premises_columns& output,
+	std::string& badLine) const
+{
+	std::vector<std::pair<const char*, const char*>> fields; // start and end of each field on a line
+	const char* pos = begin;
+	while (pos < end){
+		const char* lineEnd = (const char*)std::memchr(pos, '\n', end-pos);
+		if (lineEnd == nullptr){lineEnd = end;}
+		fields.clear();
+		bool blank = true;
+		for (const char* c = pos; c < lineEnd;){
+			if (*c == '\t'){++c; continue;}
+			const char* fieldStart = c;
+			while (c < lineEnd && *c != '\t'){
+				if (!std::isspace((unsigned char)*c)){blank = false;}
+				++c;
+			}
+			fields.emplace_back(fieldStart, c);
+		}
+		if (!blank){
+			if (fields.size() < 4+nSpecies){
+				badLine.assign(pos, lineEnd);
+				return false;
+			}
+			output.id.emplace_back(fieldToInt(fields[0].first, fields[0].second));
+			output.fips.emplace_back(fieldToInt(fields[1].first, fields[1].second));
+			output.coord1.emplace_back(fieldToDouble(fields[2].first, fields[2].second));
+			output.coord2.emplace_back(fieldToDouble(fields[3].first, fields[3].second));
+			unsigned int total = 0;
+			for (size_t i = 4; i < fields.size(); i++){ // animal populations start at column 4
+				unsigned int number = fieldToInt(fields[i].first, fields[i].second);
+				total += number;
+				if (i < 4+nSpecies){output.counts.emplace_back(number);}
+			}
+			output.totals.emplace_back(total);
+		}
+		pos = lineEnd+1;
+	}
+	return true;
+}
+
+/// Layout: identifier, version, number of species, then each column in turn.
+void Premises_file::write(const std::string& fname, const Premises_columns& input) const
+{
+	std::ofstream f(fname, std::ios::binary);
+	if (!f){
+		std::cout << "Warning (config 23): Binary premises file " << fname << " could not be written." << std::endl;
+		return;
+	}
+	f.write(premisesFileID, sizeof(premisesFileID));
+	writeBinary(f, premisesFileVersion);
+	writeBinary(f, (unsigned long long)input.nSpecies);
+	writeBinaryVec(f, input.id);
+	writeBinaryVec(f, input.fips);
+	writeBinaryVec(f, input.coord1);
+	writeBinaryVec(f, input.coord2);
+	writeBinaryVec(f, input.counts);
+	writeBinaryVec(f, input.totals);
+	f.close();
+	if (!f){
+		std::cout << "Warning (config 23): Binary premises file " << fname << " could not be written." << std::endl;
+		return;
+	}
+if (verbose>0){std::cout << input.size() << " premises written to binary premises file " << fname << std::endl;}
+}
+
+void Premises_file::readBinaryFile(const std::string& fname, Premises_columns& output)
+{
+	std::ifstream f(fname, std::ios::binary);
+	f.seekg(sizeof(premisesFileID));
+if (verbose>0){std::cout << "Binary premises file open, loading premises." << std::endl;}
+	unsigned int inVersion = 0;
+	unsigned long long inSpecies = 0;
+	if (!readBinary(f, inVersion) || inVersion != premisesFileVersion){
+		std::cout << "ERROR (config 11): Binary premises file " << fname <<
+			" was written by a different version. Convert the text premises file again (config 23). Exiting..." << std::endl;
+		Rcpp::stop("");
+	}
+	if (!readBinary(f, inSpecies) || inSpecies != nSpecies){
+		std::cout << "ERROR (premises file & config 12): Binary premises file has " << inSpecies <<
+			" species, but " << nSpecies << " species are listed. Exiting..." << std::endl;
+		Rcpp::stop("");
+	}
+	bool complete = readBinaryVec(f, output.id) && readBinaryVec(f, output.fips) &&
+		readBinaryVec(f, output.coord1) && readBinaryVec(f, output.coord2) &&
+		readBinaryVec(f, output.counts) && readBinaryVec(f, output.totals);
+	size_t n = output.id.size();
+	if (!complete || output.fips.size() != n || output.coord1.size() != n || output.coord2.size() != n ||
+		output.counts.size() != n*nSpecies || output.totals.size() != n){
+		std::cout << "ERROR (config 11): Binary premises file " << fname << " is incomplete. Exiting..." << std::endl;
+		Rcpp::stop("");
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef Premises_file_h
+#define Premises_file_h
+
+#include <string>
+#include <vector>
+
+/// Premises read from a premises file, stored by column in file order. Rows without
+/// animals are kept; Grid_manager::readFarms decides what to skip.
+struct Premises_columns
+{
+	size_t nSpecies = 0; ///< Number of animal population columns kept per premises (species in config 12)
+	std::vector<int> id; ///< Premises IDs (column 1)
+	std::vector<int> fips; ///< County FIPS codes as integers (column 2)
+	std::vector<double> coord1; ///< Column 3: x, or y if config 17 is set
+	std::vector<double> coord2; ///< Column 4: y, or x if config 17 is set
+	std::vector<int> counts; ///< Animals of each species, nSpecies values per premises
+	std::vector<unsigned int> totals; ///< Total animals in all population columns of each premises
+
+	size_t size() const; //inlined
+	void append(const Premises_columns&); ///< Adds rows from another set of columns to the end
+};
+
+/// Reads premises files, either in the tab-delimited text format (ID, FIPS, x, y, then
+/// one population column per species) or in a binary columnar format written by write().
+/// The format is detected from the start of the file. Text files are read into memory
+/// at once and parsed in chunks on several threads, without creating strings for fields.
+class Premises_file
+{
+	private:
+		size_t nSpecies; ///< Number of species (population columns required)
+		unsigned int nThreads; ///< Threads used to parse text files
+		int verbose; ///< Can be set to override global setting for console output
+
+		void readTextFile(const std::string& fname, Premises_columns& output);
+		void readBinaryFile(const std::string& fname, Premises_columns& output);
+		bool parseChunk(const char* begin, const char* end, Premises_columns& output,
+			std::string& badLine) const; ///< Parses complete lines, returns false at the first line with too few columns
+
+	public:
+		Premises_file(size_t in_nSpecies, unsigned int in_nThreads);
+		~Premises_file();
+
+		void read(const std::string& fname, Premises_columns& output); ///< Reads a text or binary premises file
+		void write(const std::string& fname, const Premises_columns& input) const; ///< Writes premises in binary columnar format
+};
+
+inline size_t Premises_columns::size() const
+{
+	return id.size();
+}
+
+#endif // Premises_file_h
@@ -6,6 +6,38 @@
 
 using namespace Rcpp;
 
+// kernel_table_coverage
+Rcpp::List kernel_table_coverage(int kernelType, std::vector<double> kernelParams, double maxDist, double maxRelError, std::vector<double> distances);
+RcppExport SEXP _usdosr_kernel_table_coverage(SEXP kernelTypeSEXP, SEXP kernelParamsSEXP, SEXP maxDistSEXP, SEXP maxRelErrorSEXP, SEXP distancesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type kernelType(kernelTypeSEXP);
+    Rcpp::traits::input_parameter< std::vector<double> >::type kernelParams(kernelParamsSEXP);
+    Rcpp::traits::input_parameter< double >::type maxDist(maxDistSEXP);
+    Rcpp::traits::input_parameter< double >::type maxRelError(maxRelErrorSEXP);
+    Rcpp::traits::input_parameter< std::vector<double> >::type distances(distancesSEXP);
+    rcpp_result_gen = Rcpp::wrap(kernel_table_coverage(kernelType, kernelParams, maxDist, maxRelError, distances));
+    return rcpp_result_gen;
+END_RCPP
+}
+
+// sampler_benchmark
+Rcpp::DataFrame sampler_benchmark(int N, double prob, double lambda, int nDraws, int seed);
+RcppExport SEXP _usdosr_sampler_benchmark(SEXP NSEXP, SEXP probSEXP, SEXP lambdaSEXP, SEXP nDrawsSEXP, SEXP seedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type N(NSEXP);
+    Rcpp::traits::input_parameter< double >::type prob(probSEXP);
+    Rcpp::traits::input_parameter< double >::type lambda(lambdaSEXP);
+    Rcpp::traits::input_parameter< int >::type nDraws(nDrawsSEXP);
+    Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
+    rcpp_result_gen = Rcpp::wrap(sampler_benchmark(N, prob, lambda, nDraws, seed));
+    return rcpp_result_gen;
+END_RCPP
+}
+
 // run_usdos
 int run_usdos(std::string cfile, bool gen_shipment_network);
 RcppExport SEXP _usdosr_run_usdos(SEXP cfileSEXP, SEXP gen_shipment_networkSEXP) {
@@ -20,6 +52,8 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_usdosr_kernel_table_coverage", (DL_FUNC) &_usdosr_kernel_table_coverage, 5},
+    {"_usdosr_sampler_benchmark", (DL_FUNC) &_usdosr_sampler_benchmark, 5},
     {"_usdosr_run_usdos", (DL_FUNC) &_usdosr_run_usdos, 2},
     {NULL, NULL, 0}
 };
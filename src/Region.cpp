@@ -71,24 +71,6 @@ Region_status::~Region_status()
 {
 }
 
-int Region_status::get_start(std::string s) const
-{
-	int output = -1;
-	if (start.count(s) > 0){
-		output = start.at(s);
-	}
-	return output;
-}
-
-int Region_status::get_end(std::string s) const
-{
-	int output = -1;
-	if (end.count(s) > 0){
-		output = end.at(s);
-	}
-	return output;
-}
-
 /// Returns the probability that exposure is prevented, based on the
 /// effectiveness of currently effective control types. If multiple control types are
 /// currently effective, the maximum effectiveness value is returned (no additive
@@ -63,18 +63,19 @@ class Region_status: public Region
 {
 	private:
 		bool reported; // at least one reported premises
-		std::vector<std::string> controlStatus; /// Vector of control statuses ever applied
+		std::vector<int> controlStatus; /// IDs of control statuses ever applied (see Status_names)
 		std::vector<double> probPreventExposure;
 		std::vector<double> probPreventTransmission;
 
-		std::unordered_map<std::string, int> start; /// Start times for each status. Assumes unique names among file, disease, and control statuses due to mapping by status name.
-		std::unordered_map<std::string, int> end; /// End times for each status. Assumes unique names among file, disease, and control statuses due to mapping by status name.
+		std::vector<int> start; /// Start times for each status, indexed by status ID (-1 if never started)
+		std::vector<int> end; /// End times for each status, indexed by status ID (-1 if never started)
+		std::vector<int> listEntry; /// Latest entry in Status_manager's list for each status, indexed by status ID (-1 if never listed)
 
 	public:
 		Region_status(Region*);
 		~Region_status();
 		void report(); //inlined
-		void add_controlStatus(std::string); //inlined
+		void add_controlStatus(int); //inlined
 
 		double get_probPreventExposure() const;
 		void add_probPreventExposure(double); //inlined
@@ -83,10 +84,12 @@ class Region_status: public Region
 		void add_probPreventTransmission(double); //inlined
 		void rem_probPreventTransmission(double);
 
- 		void set_start(const std::string, const int); //inlined - set start time for status
- 		void set_end(const std::string, const int); //inlined - set end time for status
-		int get_start(std::string) const;
- 		int get_end(std::string) const;
+ 		void set_start(const int, const int); //inlined - set start time for status
+ 		void set_end(const int, const int); //inlined - set end time for status
+ 		void set_listEntry(const int, const int); //inlined - set latest status list entry for status
+		int get_start(int) const; //inlined
+ 		int get_end(int) const; //inlined
+ 		int get_listEntry(int) const; //inlined
 		bool is_reported() const; // inlined
 };
 
@@ -94,7 +97,7 @@ inline void Region_status::report()
 {
 	reported = true;
 }
-inline void Region_status::add_controlStatus(std::string status)
+inline void Region_status::add_controlStatus(int status)
 {
 	controlStatus.emplace_back(status);
 }
@@ -110,12 +113,31 @@ inline void Region_status::add_probPreventTransmission(double eff)
 {
 	probPreventTransmission.emplace_back(eff);
 }
-inline void Region_status::set_start(const std::string status, const int t)
+inline void Region_status::set_start(const int status, const int t)
 {
+	if (size_t(status) >= start.size()){start.resize(status+1, -1);}
 	start[status] = t;
 }
-inline void Region_status::set_end(const std::string status, const int t)
+inline void Region_status::set_end(const int status, const int t)
 {
+	if (size_t(status) >= end.size()){end.resize(status+1, -1);}
 	end[status] = t;
 }
+inline void Region_status::set_listEntry(const int status, const int entry)
+{
+	if (size_t(status) >= listEntry.size()){listEntry.resize(status+1, -1);}
+	listEntry[status] = entry;
+}
+inline int Region_status::get_start(int status) const
+{
+	return size_t(status) < start.size() ? start[status] : -1;
+}
+inline int Region_status::get_end(int status) const
+{
+	return size_t(status) < end.size() ? end[status] : -1;
+}
+inline int Region_status::get_listEntry(int status) const
+{
+	return size_t(status) < listEntry.size() ? listEntry[status] : -1;
+}
 #endif // REGION_H
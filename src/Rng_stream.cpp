@@ -0,0 +1,61 @@
+#include "Rng_stream.h"
+
+#include <chrono>
+
+namespace
+{
+	thread_local Rng_stream* boundStream = nullptr; ///< Stream bound to this thread
+}
+
+Rng_stream::Rng_stream(unsigned long long seed)
+	:
+	unif_dist(0.0, 1.0),
+	norm_dist(0.0, 1.0)
+{
+	reseed(seed);
+}
+
+void Rng_stream::reseed(unsigned long long newSeed)
+{
+	seed = newSeed;
+	std::seed_seq sequence{(unsigned int)(seed & 0xffffffff), (unsigned int)(seed >> 32)};
+	generator.seed(sequence);
+	unif_dist.reset();
+	norm_dist.reset();
+	sampler = Sampler();
+}
+
+/// The child stream is seeded from both the parent seed and streamNumber (i.e. the
+/// replicate number), so the same seed and stream number always give the same sequence.
+Rng_stream Rng_stream::split(unsigned long long streamNumber) const
+{
+	std::seed_seq sequence{(unsigned int)(seed & 0xffffffff), (unsigned int)(seed >> 32),
+		(unsigned int)(streamNumber & 0xffffffff), (unsigned int)(streamNumber >> 32)};
+	unsigned int childSeed[2];
+	sequence.generate(childSeed, childSeed+2);
+	return Rng_stream(((unsigned long long)childSeed[1] << 32) | childSeed[0]);
+}
+
+unsigned long long Rng_stream::clock_seed()
+{
+	return std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+Rng_stream& Rng_stream::master()
+{
+	static Rng_stream masterStream(clock_seed());
+	return masterStream;
+}
+
+Rng_stream& Rng_stream::current()
+{
+	if (boundStream != nullptr){return *boundStream;}
+	return master();
+}
+
+Rng_stream* Rng_stream::bind(Rng_stream* s)
+{
+	Rng_stream* previous = boundStream;
+	boundStream = s;
+	return previous;
+}
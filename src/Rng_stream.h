@@ -0,0 +1,115 @@
+#ifndef Rng_stream_h
+#define Rng_stream_h
+
+#include <random>
+
+#include "Sampler.h"
+
+/// A seedable stream of pseudo-random numbers. The master stream is seeded once from the
+/// configuration file (line 8). Each replicate (or worker thread) splits off its own
+/// independent stream and binds it to the thread it runs on, so results are reproducible
+/// regardless of how replicates are scheduled. The functions in shared_functions
+/// (uniform_rand, normal_rand, rand_int, draw_binom, draw_poisson) draw from the stream
+/// bound to the calling thread, or from the master stream if none is bound.
+class Rng_stream
+{
+	private:
+		unsigned long long seed; ///< Seed this stream was started from
+		std::mt19937 generator; ///< Mersenne Twister pseudo-random number generator
+		std::uniform_real_distribution<double> unif_dist;
+		std::normal_distribution<double> norm_dist;
+		Sampler sampler; ///< Binomial and Poisson draws
+
+	public:
+		Rng_stream(unsigned long long seed = 5489);
+		void reseed(unsigned long long seed); ///< Restarts the stream from a new seed
+		Rng_stream split(unsigned long long streamNumber) const; ///< Returns an independent stream derived from this stream's seed and streamNumber
+
+		double uniform(); //inlined
+		void uniform(double* out, size_t n); //inlined
+		double normal(); //inlined
+		int integer(int lo, int hi); //inlined
+		int binom(int N, double prob); //inlined
+		void binom(const int* N, const double* prob, int* out, size_t n); //inlined
+		int poisson(double lambda); //inlined
+		void poisson(double lambda, int* out, size_t n); //inlined
+		unsigned int draw_seed(); //inlined
+		std::mt19937& get_generator(); //inlined
+		unsigned long long get_seed() const; //inlined
+
+		static unsigned long long clock_seed(); ///< Seed taken from the current time, used if no seed is given in config
+		static Rng_stream& master(); ///< Process-wide stream seeded from config
+		static Rng_stream& current(); ///< Stream bound to the calling thread, or the master stream if none is bound
+		static Rng_stream* bind(Rng_stream*); ///< Binds a stream to the calling thread (nullptr to unbind), returns the stream bound before
+};
+
+/// Binds a stream to the calling thread for the lifetime of this object, then restores
+/// the stream bound before (so bindings can be nested)
+struct Rng_binding
+{
+	Rng_stream* previous;
+	Rng_binding(Rng_stream* s){previous = Rng_stream::bind(s);}
+	~Rng_binding(){Rng_stream::bind(previous);}
+};
+
+inline double Rng_stream::uniform()
+{
+	return unif_dist(generator);
+}
+
+/// Fills out with n draws, in the same order as n calls to uniform()
+inline void Rng_stream::uniform(double* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++){out[i] = unif_dist(generator);}
+}
+
+inline double Rng_stream::normal()
+{
+	return norm_dist(generator);
+}
+
+inline int Rng_stream::integer(int lo, int hi)
+{
+	std::uniform_int_distribution<int> int_dist(lo, hi);
+	return int_dist(generator);
+}
+
+inline int Rng_stream::binom(int N, double prob)
+{
+	return sampler.binom(generator, N, prob);
+}
+
+/// Fills out with binomial draws for n (N, prob) pairs
+inline void Rng_stream::binom(const int* N, const double* prob, int* out, size_t n)
+{
+	sampler.binom(generator, N, prob, out, n);
+}
+
+inline int Rng_stream::poisson(double lambda)
+{
+	return sampler.poisson(generator, lambda);
+}
+
+/// Fills out with n Poisson draws with mean lambda
+inline void Rng_stream::poisson(double lambda, int* out, size_t n)
+{
+	sampler.poisson(generator, lambda, out, n);
+}
+
+/// Returns a number from this stream to seed another generator (i.e. gsl_rng)
+inline unsigned int Rng_stream::draw_seed()
+{
+	return generator();
+}
+
+inline std::mt19937& Rng_stream::get_generator()
+{
+	return generator;
+}
+
+inline unsigned long long Rng_stream::get_seed() const
+{
+	return seed;
+}
+
+#endif // Rng_stream_h
@@ -0,0 +1,185 @@
+#include <algorithm> // std::min
+#include <chrono> // timing in sampler_benchmark
+#include <cmath> // std::exp, std::log1p
+
+#include <Rcpp.h>
+
+#include "Sampler.h"
+
+constexpr double Sampler::inversionMaxMean;
+
+Sampler::Sampler()
+	:
+	unif_dist(0.0, 1.0),
+	expLambda(1),
+	lastLambda(0)
+{
+}
+
+int Sampler::binom(std::mt19937& generator, int N, double prob)
+{
+	if (N <= 0 || prob <= 0){return 0;}
+	if (prob >= 1){return N;}
+	if (prob > 0.5){return N - binom(generator, N, 1-prob);}
+	if (N*prob < inversionMaxMean){return binomInversion(N, prob, unif_dist(generator));}
+	return binomLarge(generator, N, prob);
+}
+
+int Sampler::poisson(std::mt19937& generator, double lambda)
+{
+	if (lambda <= 0){return 0;}
+	if (lambda < inversionMaxMean){return poissonInversion(lambda, unif_dist(generator));}
+	return poissonLarge(generator, lambda);
+}
+
+/// One uniform is drawn for every pair (used only by those drawn by inversion), so the
+/// loop deciding most of them is over arrays.
+/// \param[in] generator Generator to draw from
+/// \param[in] N Numbers of trials
+/// \param[in] prob Probabilities of success
+/// \param[out] out Numbers of successes
+/// \param[in] n Number of (N, prob) pairs
+void Sampler::binom(std::mt19937& generator, const int* N, const double* prob, int* out, size_t n)
+{
+	uniforms.resize(n);
+	for (size_t i = 0; i < n; i++){uniforms[i] = unif_dist(generator);}
+	for (size_t i = 0; i < n; i++){
+		out[i] = binomFromUniform(generator, N[i], prob[i], uniforms[i]);
+	}
+}
+
+void Sampler::poisson(std::mt19937& generator, double lambda, int* out, size_t n)
+{
+	if (lambda <= 0){
+		for (size_t i = 0; i < n; i++){out[i] = 0;}
+	} else if (lambda < inversionMaxMean){
+		for (size_t i = 0; i < n; i++){out[i] = poissonInversion(lambda, unif_dist(generator));}
+	} else {
+		for (size_t i = 0; i < n; i++){out[i] = poissonLarge(generator, lambda);}
+	}
+}
+
+int Sampler::binomFromUniform(std::mt19937& generator, int N, double prob, double u)
+{
+	if (N <= 0 || prob <= 0){return 0;}
+	if (prob >= 1){return N;}
+	if (prob > 0.5){return N - binomFromUniform(generator, N, 1-prob, u);}
+	if (N*prob < inversionMaxMean){return binomInversion(N, prob, u);}
+	return binomLarge(generator, N, prob);
+}
+
+/// Steps through the cumulative distribution until it exceeds u. P(0) = (1-prob)^N is at
+/// least 1 - N*prob, so smaller u give 0 without calculating P(0).
+int Sampler::binomInversion(int N, double prob, double u)
+{
+	if (u < 1 - N*prob){return 0;}
+	double ratio = prob/(1 - prob);
+	double pk = std::exp(N*std::log1p(-prob)); // P(0)
+	int k = 0;
+	while (u >= pk && k < N && pk > 0){ // pk only reaches 0 by rounding
+		u -= pk;
+		pk *= ratio*(N-k)/(k+1); // P(k+1) from P(k)
+		++k;
+	}
+	return k;
+}
+
+/// As binomInversion: P(0) = exp(-lambda) is at least 1 - lambda
+int Sampler::poissonInversion(double lambda, double u)
+{
+	if (u < 1 - lambda){return 0;}
+	if (lambda != lastLambda){
+		expLambda = std::exp(-lambda);
+		lastLambda = lambda;
+	}
+	double pk = expLambda; // P(0)
+	int k = 0;
+	while (u >= pk && pk > 0){ // pk only reaches 0 by rounding
+		u -= pk;
+		++k;
+		pk *= lambda/k; // P(k) from P(k-1)
+	}
+	return k;
+}
+
+int Sampler::binomLarge(std::mt19937& generator, int N, double prob)
+{
+	if (binom_dist.t() != N || binom_dist.p() != prob){
+		binom_dist.param(std::binomial_distribution<int>::param_type(N, prob));
+	}
+	return binom_dist(generator);
+}
+
+int Sampler::poissonLarge(std::mt19937& generator, double lambda)
+{
+	if (poisson_dist.mean() != lambda){
+		poisson_dist.param(std::poisson_distribution<int>::param_type(lambda));
+	}
+	return poisson_dist(generator);
+}
+
+/// Used by inst/benchmarks/sampler_benchmark.R and tests/testthat/test-sampler.R to compare
+/// Sampler with the implementation it replaced (a new standard library distribution for
+/// every draw, as in draw_binom and draw_poisson before). Each method makes nDraws binomial
+/// and nDraws Poisson draws from a generator seeded with seed.
+/// \param[in] N	Number of trials for binomial draws
+/// \param[in] prob	Probability of success for binomial draws
+/// \param[in] lambda	Mean of Poisson draws
+/// \param[in] nDraws	Number of draws of each kind per method
+/// \param[in] seed	Seed of the generator (the same for each method)
+/// \returns Data frame with one row per method: time in ms and mean of the draws
+// [[Rcpp::export(.sampler_benchmark)]]
+Rcpp::DataFrame sampler_benchmark(int N, double prob, double lambda, int nDraws, int seed)
+{
+	typedef std::chrono::steady_clock Clock;
+	const size_t batchSize = 1024;
+	std::vector<int> batchN(batchSize, N), batchOut(batchSize);
+	std::vector<double> batchProb(batchSize, prob);
+	Rcpp::NumericVector binomMs(3), binomMean(3), poissonMs(3), poissonMean(3);
+	for (int method = 0; method < 3; method++){
+		std::mt19937 generator(seed);
+		Sampler sampler;
+		double sum = 0;
+		Clock::time_point start = Clock::now();
+		if (method == 0){ // previous implementation
+			for (int i = 0; i < nDraws; i++){
+				std::binomial_distribution<int> binom_dist(N, prob);
+				sum += binom_dist(generator);
+			}
+		} else if (method == 1){ // one draw at a time
+			for (int i = 0; i < nDraws; i++){sum += sampler.binom(generator, N, prob);}
+		} else { // batched
+			for (int i = 0; i < nDraws; i += batchSize){
+				size_t n = std::min(batchSize, size_t(nDraws - i));
+				sampler.binom(generator, batchN.data(), batchProb.data(), batchOut.data(), n);
+				for (size_t j = 0; j < n; j++){sum += batchOut[j];}
+			}
+		}
+		binomMs[method] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		binomMean[method] = nDraws > 0 ? sum/nDraws : 0;
+
+		sum = 0;
+		start = Clock::now();
+		if (method == 0){
+			for (int i = 0; i < nDraws; i++){
+				std::poisson_distribution<int> p_dist(lambda);
+				sum += p_dist(generator);
+			}
+		} else if (method == 1){
+			for (int i = 0; i < nDraws; i++){sum += sampler.poisson(generator, lambda);}
+		} else {
+			for (int i = 0; i < nDraws; i += batchSize){
+				size_t n = std::min(batchSize, size_t(nDraws - i));
+				sampler.poisson(generator, lambda, batchOut.data(), n);
+				for (size_t j = 0; j < n; j++){sum += batchOut[j];}
+			}
+		}
+		poissonMs[method] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		poissonMean[method] = nDraws > 0 ? sum/nDraws : 0;
+	}
+	return Rcpp::DataFrame::create(
+		Rcpp::Named("method") = Rcpp::CharacterVector::create("new distribution per draw", "Sampler", "Sampler, batched"),
+		Rcpp::Named("binomialMs") = binomMs, Rcpp::Named("binomialMean") = binomMean,
+		Rcpp::Named("poissonMs") = poissonMs, Rcpp::Named("poissonMean") = poissonMean,
+		Rcpp::Named("stringsAsFactors") = false);
+}
@@ -0,0 +1,41 @@
+#ifndef Sampler_h
+#define Sampler_h
+
+#include <random>
+#include <vector>
+
+/// Draws binomial and Poisson random numbers from a generator, keeping what it can between
+/// calls. Small means (below inversionMaxMean) are drawn by inversion from one uniform
+/// number, returning 0 without any further calculation when the uniform is below a lower
+/// bound of P(0) (the usual case for the tiny probabilities of local spread between
+/// distant cells). Larger means use the standard library distributions, which are only
+/// rebuilt when the parameters change. Each Rng_stream has its own Sampler.
+class Sampler
+{
+	private:
+		std::uniform_real_distribution<double> unif_dist;
+		std::binomial_distribution<int> binom_dist; ///< Used for large means, kept for repeated parameters
+		std::poisson_distribution<int> poisson_dist; ///< Used for large means, kept for repeated parameters
+		double expLambda; ///< exp(-lambda) for the last small Poisson mean
+		double lastLambda; ///< Last small Poisson mean, for which expLambda was calculated
+		std::vector<double> uniforms; ///< Reusable array for batched draws
+
+		int binomFromUniform(std::mt19937& generator, int N, double prob, double u); ///< Binomial using uniform u if drawn by inversion
+		int binomInversion(int N, double prob, double u); ///< Binomial with N*prob < inversionMaxMean from uniform u
+		int poissonInversion(double lambda, double u); ///< Poisson with lambda < inversionMaxMean from uniform u
+		int binomLarge(std::mt19937& generator, int N, double prob); ///< Binomial from binom_dist
+		int poissonLarge(std::mt19937& generator, double lambda); ///< Poisson from poisson_dist
+
+	public:
+		static constexpr double inversionMaxMean = 10; ///< Means below this are drawn by inversion
+
+		Sampler();
+		int binom(std::mt19937& generator, int N, double prob); ///< Number of successes in N trials with probability prob
+		int poisson(std::mt19937& generator, double lambda); ///< Poisson random number with mean lambda
+		///> Binomial numbers for n (N, prob) pairs, drawing the uniforms for all of them first
+		void binom(std::mt19937& generator, const int* N, const double* prob, int* out, size_t n);
+		///> n Poisson numbers with the same mean
+		void poisson(std::mt19937& generator, double lambda, int* out, size_t n);
+};
+
+#endif // Sampler_h
@@ -92,25 +92,24 @@ void Shipment_manager::makeShipmentsMultinomial(size_t timestep, size_t days_in_
     //Select what farms will be involved in the generation of shipments.
     //Running with an empty infFarms is a signal to generating a full network of shipments,
     //so then we use all farms.
-    std::vector<Farm*> affected_farms;
-    affected_farms.reserve(1000000);
+    //infFarms is used as is, so only the full network needs a list of its own.
+    std::vector<Farm*> all_farms;
+    const std::vector<Farm*>* affected_farms = &infFarms;
     size_t day_of_year = get_day_of_year(timestep, parameters->start_day);
     if(infFarms.empty())
     {
+        all_farms.reserve(1000000);
         for(County* c : allCounties)
         {
             std::vector<Farm*> c_farms = c->get_farms();
-            affected_farms.insert(affected_farms.end(), c_farms.begin(), c_farms.end());
+            all_farms.insert(all_farms.end(), c_farms.begin(), c_farms.end());
         }
-    }
-    else
-    {
-        affected_farms.assign(infFarms.begin(), infFarms.end());
+        affected_farms = &all_farms;
     }
 
     //Sort all affected farms according to farm type and state.
     std::map<Farm_type*, std::map<State*, std::vector<Farm*>>> affected_farms_by_ft_state;
-    for(Farm* f : affected_farms)
+    for(Farm* f : *affected_farms)
     {
         affected_farms_by_ft_state[f->get_farm_type()][f->get_parent_state()].push_back(f);
     }
@@ -244,7 +243,7 @@ void Shipment_manager::makeNetwork(std::vector<std::string> out_fnames, Grid_man
     std::cout << "...done." << std::endl;
 }
 
-Farm* Shipment_manager::largestStatus(std::vector<Farm*>& premVec, std::string& status)
+Farm* Shipment_manager::largestStatus(std::vector<Farm*>& premVec, int status)
 {
     if(S == nullptr)
     {
@@ -256,7 +255,7 @@ Farm* Shipment_manager::largestStatus(std::vector<Farm*>& premVec, std::string&
 	bool found = 0;
 	auto i = premVec.back(); // start at end of sorted vector (largest prem) and work backwards
 	while (found==0){
-		if(S->getAny_diseaseStatus(i).compare(status)==0){ // if prem has this status, stop and return this prem
+		if(S->getAny_diseaseStatus(i) == status){ // if prem has this status, stop and return this prem
 			found = 1;
 		} else if ( i>premVec.front() ){i--; // keep moving backwards
 		} else if ( i==premVec.front() ){ i = premVec.back(); found = 1;} // if no prems have this status, return largest
@@ -291,6 +290,8 @@ if(verbose>1){std::cout << "The destination county (" << dest_county->get_id() <
                         day_of_year,
                         origin_farm->get_id(),
                         destination_farm->get_id(),
+                        origin_farm->get_ordinal(),
+                        destination_farm->get_ordinal(),
                         origin_county->get_id(),
                         dest_county->get_id(),
                         origin_type->get_species(),
@@ -19,6 +19,8 @@ struct Shipment // used in Shipment, Status
 	size_t day_of_year; ///< Day of the year of the shipment.
 	int origID; ///< Premises ID of shipment origin
 	int destID; ///< Premises ID of shipment destination
+	int origOrdinal; ///< Ordinal of shipment origin premises (see Farm::get_ordinal)
+	int destOrdinal; ///< Ordinal of shipment destination premises
 	std::string origFIPS; ///< County ID of shipment origin
 	std::string destFIPS; ///< County ID of shipment destination
 	std::string species; ///< Species or animal type in shipment
@@ -73,7 +75,7 @@ class Shipment_manager
 
 		// functions
 		void initialize();
-		Farm* largestStatus(std::vector<Farm*>&, std::string&); ///< Finds largest premises with "status", from vector sorted by population
+		Farm* largestStatus(std::vector<Farm*>&, int status); ///< Finds largest premises with disease status ID "status", from vector sorted by population
 
 		///Creates and returns a pointer to a shipment struct.
 		Shipment* generateInfectiousShipment(Farm* origin_farm, size_t timestep, size_t day_of_year,
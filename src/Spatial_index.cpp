@@ -0,0 +1,119 @@
+#include <algorithm> // std::sort, std::unique, std::min, std::max
+#include <cmath> // std::floor
+
+#include "Spatial_index.h"
+#include "Farm.h"
+
+Spatial_index::Spatial_index()
+	:
+	xMin(0),
+	yMin(0),
+	side(1),
+	nx(0),
+	ny(0)
+{
+}
+
+Spatial_index::~Spatial_index()
+{
+}
+
+/// \param[in] premises All premises to index
+/// \param[in] bucketSide Width of buckets. Widened if needed so there are at most about
+/// four buckets per premises.
+void Spatial_index::build(const std::vector<Farm*>& premises, double bucketSide)
+{
+	bucketStart.clear();
+	premX.clear();
+	premY.clear();
+	prems.clear();
+	if (premises.empty() || bucketSide <= 0){return;}
+
+	double xMax = premises.front()->Farm::get_x();
+	double yMax = premises.front()->Farm::get_y();
+	xMin = xMax;
+	yMin = yMax;
+	for (auto& f:premises){
+		xMin = std::min(xMin, f->Farm::get_x());
+		xMax = std::max(xMax, f->Farm::get_x());
+		yMin = std::min(yMin, f->Farm::get_y());
+		yMax = std::max(yMax, f->Farm::get_y());
+	}
+	side = bucketSide;
+	double maxBuckets = 4.0*premises.size() + 1;
+	while ((std::floor((xMax-xMin)/side)+1) * (std::floor((yMax-yMin)/side)+1) > maxBuckets){
+		side *= 2;
+	}
+	nx = int((xMax-xMin)/side) + 1;
+	ny = int((yMax-yMin)/side) + 1;
+
+	// counting sort of premises into buckets, keeping input order within each bucket
+	std::vector<unsigned int> whichBucket(premises.size());
+	bucketStart.assign(size_t(nx)*ny + 1, 0);
+	for (size_t i = 0; i < premises.size(); i++){
+		whichBucket[i] = row(premises[i]->Farm::get_y())*nx + column(premises[i]->Farm::get_x());
+		++bucketStart[whichBucket[i] + 1];
+	}
+	for (size_t b = 1; b < bucketStart.size(); b++){bucketStart[b] += bucketStart[b-1];}
+	std::vector<unsigned int> next(bucketStart.begin(), bucketStart.end()-1);
+	premX.resize(premises.size());
+	premY.resize(premises.size());
+	prems.resize(premises.size());
+	for (size_t i = 0; i < premises.size(); i++){
+		unsigned int pos = next[whichBucket[i]]++;
+		premX[pos] = premises[i]->Farm::get_x();
+		premY[pos] = premises[i]->Farm::get_y();
+		prems[pos] = premises[i];
+	}
+}
+
+/// \param[in] x x-coordinate of center of circle
+/// \param[in] y y-coordinate of center of circle
+/// \param[in] radius radius of circle (same units as premises coordinates)
+/// \param[in] radiusSquared radius*radius, pre-calculated for efficiency
+/// \param[out] output Vector to which (distance squared, premises) pairs are added, in no particular order
+void Spatial_index::inRadius(double x, double y, double radius, double radiusSquared,
+	std::vector<std::pair<double, Farm*>>& output) const
+{
+	if (empty()){return;}
+	int colFirst = column(x - radius);
+	int colLast = column(x + radius);
+	int rowFirst = row(y - radius);
+	int rowLast = row(y + radius);
+	for (int r = rowFirst; r <= rowLast; r++){
+		// buckets in a row are contiguous, so each row of the bounding box is one range
+		unsigned int first = bucketStart[r*nx + colFirst];
+		unsigned int last = bucketStart[r*nx + colLast + 1];
+		for (unsigned int i = first; i < last; i++){
+			double xdiff = premX[i] - x;
+			double ydiff = premY[i] - y;
+			double distanceSquared = xdiff*xdiff + ydiff*ydiff;
+			if (distanceSquared <= radiusSquared){
+				output.emplace_back(distanceSquared, prems[i]);
+			}
+		}
+	}
+}
+
+/// Used to combine neighbors of several focal premises: each premises is kept once, at its
+/// distance from the closest focal premises.
+void Spatial_index::nearestFirst(std::vector<std::pair<double, Farm*>>& distancesNeighbors)
+{
+	auto byPremises = [](const std::pair<double, Farm*>& a, const std::pair<double, Farm*>& b){
+		if (a.second->Farm::get_id() != b.second->Farm::get_id()){
+			return a.second->Farm::get_id() < b.second->Farm::get_id();
+		}
+		return a.first < b.first;
+	};
+	auto samePremises = [](const std::pair<double, Farm*>& a, const std::pair<double, Farm*>& b){
+		return a.second == b.second;
+	};
+	auto byDistance = [](const std::pair<double, Farm*>& a, const std::pair<double, Farm*>& b){
+		if (a.first != b.first){return a.first < b.first;}
+		return a.second->Farm::get_id() < b.second->Farm::get_id();
+	};
+	std::sort(distancesNeighbors.begin(), distancesNeighbors.end(), byPremises);
+	distancesNeighbors.erase(std::unique(distancesNeighbors.begin(), distancesNeighbors.end(), samePremises),
+		distancesNeighbors.end());
+	std::sort(distancesNeighbors.begin(), distancesNeighbors.end(), byDistance);
+}
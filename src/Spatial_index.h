@@ -0,0 +1,65 @@
+#ifndef Spatial_index_h
+#define Spatial_index_h
+
+#include <utility> // std::pair
+#include <vector>
+
+class Farm;
+
+/// Uniform grid of square buckets over all premises, for finding premises within a radius
+/// of a point. Premises are stored bucket by bucket in flat arrays (compressed sparse rows),
+/// so a query only reads the buckets overlapping the circle's bounding box. Buckets are
+/// best about as wide as the smallest radius that will be queried.
+class Spatial_index
+{
+	private:
+		double xMin; ///< x-coordinate of the west edge of the first column of buckets
+		double yMin; ///< y-coordinate of the south edge of the first row of buckets
+		double side; ///< Width of each bucket (same units as premises coordinates)
+		int nx; ///< Number of columns of buckets
+		int ny; ///< Number of rows of buckets
+		std::vector<unsigned int> bucketStart; ///< Start of each bucket's premises in the arrays below, nx*ny+1 elements
+		std::vector<double> premX; ///< x-coordinates of premises, grouped by bucket
+		std::vector<double> premY; ///< y-coordinates of premises, grouped by bucket
+		std::vector<Farm*> prems; ///< Premises, grouped by bucket
+
+		int column(double x) const; //inlined
+		int row(double y) const; //inlined
+
+	public:
+		Spatial_index();
+		~Spatial_index();
+
+		void build(const std::vector<Farm*>& premises, double bucketSide); ///< Sorts premises into buckets
+		bool empty() const; //inlined
+		double get_side() const; //inlined
+		///> Appends (distance squared, premises) for all premises within radius of (x, y)
+		void inRadius(double x, double y, double radius, double radiusSquared,
+			std::vector<std::pair<double, Farm*>>& output) const;
+		///> Keeps the smallest distance for each premises and sorts by distance, then ID
+		static void nearestFirst(std::vector<std::pair<double, Farm*>>& distancesNeighbors);
+};
+
+inline int Spatial_index::column(double x) const
+{
+	double c = (x - xMin)/side;
+	return c < 0 ? 0 : (c >= nx ? nx-1 : int(c));
+}
+
+inline int Spatial_index::row(double y) const
+{
+	double r = (y - yMin)/side;
+	return r < 0 ? 0 : (r >= ny ? ny-1 : int(r));
+}
+
+inline bool Spatial_index::empty() const
+{
+	return bucketStart.empty();
+}
+
+inline double Spatial_index::get_side() const
+{
+	return side;
+}
+
+#endif // Spatial_index_h
@@ -4,66 +4,97 @@
 
 /// Establishes sequences of statuses for disease, file status, and control statuses.
 /// Sets seed farm(s) as exposed, using index reporting time for reporting.
+/// \param[in] statusTable Table of premises statuses, empty, to be used for this replicate (and cleared
+/// when it ends)
 Status_manager::Status_manager(std::vector<Farm*>& focalFarms, const Parameters* parameters,
-	Grid_manager* grid, Control_manager* control) :
+	Grid_manager* grid, Control_manager* control, Prem_status_table* statusTable) :
 		seededFarms(focalFarms), // saved for output
 		parameters(parameters),
 		controlManager(control),
 		gridManager(grid),
-    allPrems(grid->get_allFarms()),
+    allPrems(&grid->get_allFarms_vector()),
     allCounties(grid->get_allCounties()),
     allStates(grid->get_allStates()),
     allControlTypes(control->get_controlTypes()),
     controlResources(control->get_controlResources()),
     controlReleaseSchedule(control->get_resourceBoostSchedule()),
+    names(&parameters->statusNames),
     recentNotSus(0),
     pastEndTime(std::make_tuple(parameters->timesteps+100, 0)),
-    nPrems(allPrems->size()),
-    species(parameters->species) // store species for formatting later
+    nPrems(grid->get_allFarms()->size()),
+    species(parameters->species), // store species for formatting later
+    changedStatus(statusTable)
 {
 	verbose = verboseLevel;
 
+	// status lists and sequences by status ID, waitlists by control type ID
+	int nStatuses = names->size();
+	statusSequences.assign(nStatuses, statusShift{pastEndTime, -1});
+	fileStatuses.resize(nStatuses);
+	diseaseStatuses.resize(nStatuses);
+	controlStatuses.resize(nStatuses);
+	regionControlStatuses.resize(nStatuses);
+	waitlist.resize(names->nControlTypes());
+	waitlistRegion.resize(names->nControlTypes());
+	controlTypeByID.assign(names->nControlTypes(), nullptr);
+	for (auto& ct:*allControlTypes){
+		controlTypeByID.at(names->controlTypeID(ct.first)) = ct.second;
+	}
+	vaxType = names->controlTypeID("vax");
+	dcEvaluated = 0;
+	for (auto& r:(parameters->dcRiskScale)){
+		int s = names->id(r.first);
+		if (s < 0 || s >= int(8*sizeof(dcEvaluated))){
+			std::cout<<"ERROR (config 74): Dangerous contacts can't be evaluated for status "<<r.first<<
+			". Exiting..."<<std::endl;
+			Rcpp::stop("");
+		}
+		dcEvaluated |= 1u << s;
+	}
+
 	// Specify duration of each disease status and what follows
-	statusShift exp {parameters->latencyParams, "inf"};
-	statusSequences["exp"] = exp;
+	statusShift exp {parameters->latencyParams, statusInf};
+	statusSequences[statusExp] = exp;
 
-	statusShift inf {parameters->infectiousParams, "imm"};
-	statusSequences["inf"] = inf;
+	statusShift inf {parameters->infectiousParams, statusImm};
+	statusSequences[statusInf] = inf;
 
-	statusShift imm {pastEndTime, "NA"};
-	statusSequences["imm"] = imm;
+	statusShift imm {pastEndTime, -1};
+	statusSequences[statusImm] = imm;
 
 	// set seed farms as exposed
 	for (auto& f:focalFarms){
-		set_status(f, 1, "exp", parameters->latencyParams); // "exp" = disease status exposed
-        //get farm id
-        int fid = f->Farm::get_id();
+		set_status(f, 1, statusExp, parameters->latencyParams); // disease status exposed
         //set exposure time for source farms
         //record exposedBy by itself
         //route is local spread
         //not blocked
-        changedStatus.at(fid)->Prem_status::add_exposureSource(1, f, 0, "none");
+        changedStatus->find(f)->Prem_status::add_exposureSource(1, f, 0, "none");
 	}
 
 	if (parameters->control_on == true){
-		statusShift exposed {pastEndTime, "reported"};
+		statusShift exposed {pastEndTime, statusReported};
 		// End times for fileStatus 'exposed' differs depending on dangerousContact status, handled in expose() and set_status(). pastEndTime put in as placeholder.
-		statusSequences["exposed"] = exposed;
-		statusShift reported {pastEndTime, "NA"}; // 'reported' status is permanent
-		statusSequences["reported"] = reported;
+		statusSequences[statusExposed] = exposed;
+		statusShift reported {pastEndTime, -1}; // 'reported' status is permanent
+		statusSequences[statusReported] = reported;
 
 		// Specify duration of each control status and what follows
 		for (auto& ct:(parameters->controlTypes)){
 			std::string c_type = ct;
+			int ctID = names->controlTypeID(c_type);
+			int implementedID = Status_names::controlStatus(ctID, stageImplemented);
+			int effectiveID = Status_names::controlStatus(ctID, stageEffective);
+			int inactiveID = Status_names::controlStatus(ctID, stageInactive);
 
-			statusShift implemented {parameters->implementToEffectiveLag.at(c_type), "effective."+c_type};
-			statusSequences["implemented."+c_type] = implemented;
+			statusShift implemented {parameters->implementToEffectiveLag.at(c_type), effectiveID};
+			statusSequences[implementedID] = implemented;
 
-			statusShift effective {parameters->effectiveToInactiveLag.at(c_type), "inactive."+c_type};
-			statusSequences["effective."+c_type] = effective;
+			statusShift effective {parameters->effectiveToInactiveLag.at(c_type), inactiveID};
+			statusSequences[effectiveID] = effective;
 
-			statusShift inactive {pastEndTime, "NA"};
-			statusSequences["inactive."+c_type] = inactive;
+			statusShift inactive {pastEndTime, -1};
+			statusSequences[inactiveID] = inactive;
 		}
 
 		// set seed farms as exposed (fileStatus), for reporting
@@ -71,14 +102,14 @@ Status_manager::Status_manager(std::vector<Farm*>& focalFarms, const Parameters*
 		for (auto& f:focalFarms){
 			int indexReportTime = normDelay(iReport); // current time + index report delay
 			std::tuple<double, double> indexReportTuple = std::make_tuple(indexReportTime, 0);
-			set_status(f, 1, "exposed", indexReportTuple); // file status
+			set_status(f, 1, statusExposed, indexReportTuple); // file status
 		}
 	}
 
 if (verbose>1){
 	std::cout<<focalFarms.size()<<" exposed premises initiated. End times for exposed premises: "<<std::endl;
-	for (auto& e : diseaseStatuses.at("exp").units){
-		std::cout << e->get_end("exp") << ", ";
+	for (auto& e : diseaseStatuses[statusExp].units){
+		std::cout << e->get_end(statusExp) << ", ";
 	}
 	std::cout<<std::endl;
 }
@@ -90,20 +121,15 @@ if(verbose > 0){
 
 Status_manager::~Status_manager()
 {
-	for (auto& f:changedStatus){delete f.second;}
+	changedStatus->clear();
 	for (auto& c:changedCoStatus){delete c.second;}
 	for (auto& c:changedStateStatus){delete c.second;}
 }
 
 /// Checks if a Prem_status exists for a premises and creates one if not. Returns
-/// identifier for premises that is used as index value in changedStatus.
-int Status_manager::verify_premStatus(Farm* f){
-	int fid = f->Farm::get_id();
-	// if a prem_status object has not yet been made for this farm, make one
-	if (changedStatus.count(fid)==0){
-		changedStatus[fid] = new Prem_status(f);
-	}
-	return fid;
+/// the Prem_status.
+Prem_status* Status_manager::verify_premStatus(Farm* f){
+	return changedStatus->add(f);
 }
 
 /// Records confirmed exposure sources for a Prem_status without having to set disease
@@ -113,8 +139,7 @@ int Status_manager::verify_premStatus(Farm* f){
 void Status_manager::add_premSource(int t, Farm* toBeExposed, Farm* exposedBy,
 	int route, std::string prevented)
 {
-	int fid = verify_premStatus(toBeExposed);
-	changedStatus.at(fid)->Prem_status::add_exposureSource(t, exposedBy, route, prevented);
+	verify_premStatus(toBeExposed)->Prem_status::add_exposureSource(t, exposedBy, route, prevented);
 	// Also add info to "sources" for printing
 	sources.emplace_back(std::make_tuple(toBeExposed, exposedBy, route, prevented));
 }
@@ -129,144 +154,136 @@ void Status_manager::add_premSource(int t, Farm* toBeExposed, Farm* exposedBy,
 ///	\param[in]	statusDuration	Tuple of mean, variance in days until next status begins. For permanent statuses (i.e. reported), use mean=pastEndTime, var=0
 /// \param[in] 	controlEffect Optional argument needed when setting control to effective or inactive
 
-void Status_manager::set_status(Farm* f, int startTime, std::string status,
+void Status_manager::set_status(Farm* f, int startTime, int status,
 	std::tuple<double,double> statusDuration, std::tuple<double, double> controlEffect)
 {
-	int fid = verify_premStatus(f);
+	Prem_status* fStatus = verify_premStatus(f);
 
 	// if lag time = 0, use next status & duration instead
 	while (std::get<0>(statusDuration) == 0){
-		if (statusSequences.at(status).next.compare("NA")!=0){ // if there is a next status
-			status = statusSequences.at(status).next; // overwrite status as the next status
-			statusDuration = statusSequences.at(status).duration; // get duration of that status
+		if (statusSequences[status].next != -1){ // if there is a next status
+			status = statusSequences[status].next; // overwrite status as the next status
+			statusDuration = statusSequences[status].duration; // get duration of that status
 		} else {
 			// leave status as is and set duration to pastEndTime
 			statusDuration = pastEndTime;
 		}
 	}
 
-if(verbose>1){std::cout<<"SM::set_status: Setting "<<fid<<" status to ";}
+if(verbose>1){std::cout<<"SM::set_status: Setting "<<f->Farm::get_id()<<" status to ";}
+
+	statusList<Prem_status*>* list = nullptr; // list that fStatus is added to
+	unsigned int entry = 0; // entry of fStatus in list
 
 	// if status is a disease status:
-	if (status.compare("exp")==0 ||
-			status.compare("inf")==0 ||
-			status.compare("imm")==0){
+	if (Status_names::isDisease(status)){
 
-		if(verbose>1){std::cout<<status<<" (disease status)"<<std::endl;}
+		if(verbose>1){std::cout<<names->name(status)<<" (disease status)"<<std::endl;}
 
-		changedStatus.at(fid)->Prem_status::set_diseaseStatus(status);
+		fStatus->Prem_status::set_diseaseStatus(status);
 		// add to appropriate statusList
-		if (diseaseStatuses.count(status)==0){
-			diseaseStatuses[status].lo = 0; // set placeholder at beginning
-		}
-		diseaseStatuses.at(status).units.emplace_back(changedStatus.at(fid));
+		list = &diseaseStatuses[status];
+		entry = list->add(fStatus, status);
 
-		if (status.compare("exp")==0){ // if farm is becoming exposed
-			notSus.emplace_back(allPrems->at(fid)); // add to list of non-susceptibles
+		if (status == statusExp){ // if farm is becoming exposed
+			notSus.emplace_back((*allPrems)[f->Farm::get_ordinal()]); // add to list of non-susceptibles
 		}
 
 	// if status is a file status (applies to all types of control):
-	// other fileStatus: notDangerousContact
-	} else if (status.compare("dangerousContact")==0 ||
-						 status.compare("exposed")==0 ||
-						 status.compare("reported")==0){
+	// dangerousContact, exposed or reported (other fileStatus: notDangerousContact)
+	} else if (Status_names::isFile(status)){
 
-		if(verbose>1){std::cout<<status<<" (file status)"<<std::endl;}
+		if(verbose>1){std::cout<<names->name(status)<<" (file status)"<<std::endl;}
 
-		changedStatus.at(fid)->Prem_status::set_fileStatus(status);
+		fStatus->Prem_status::set_fileStatus(status);
 		// add to appropriate file-status list
-		if (fileStatuses.count(status)==0){
-			fileStatuses[status].lo = 0; // set placeholder at beginning
-		}
-		fileStatuses.at(status).units.emplace_back(changedStatus.at(fid));
+		list = &fileStatuses[status];
+		entry = list->add(fStatus, status);
 
-		if (status.compare("reported")==0){
-			newPremReports.emplace_back(changedStatus.at(fid));
+		if (status == statusReported){
+			newPremReports.emplace_back(fStatus);
 			if (parameters->dangerousContacts_on==1){
 				// determine which of potential dangerous contacts will be dangerous contacts
-				std::unordered_map<Farm*, std::unordered_map<std::string, bool>> pDCs =
-					*(changedStatus.at(fid)->Prem_status::get_potentialDCs());
+				std::unordered_map<Farm*, unsigned int> pDCs = *(fStatus->Prem_status::get_potentialDCs());
 if(verbose>1 && pDCs.size()>0){std::cout<<"SM::Reported farm has "<<pDCs.size()<<" potential DCs"<<std::endl;}
 				for (auto& dc:pDCs){ // dc.first is prem to evaluated as DC
 
-if (verbose>1){std::cout<<dc.first->Farm::get_id()<<" is DC/reported? "<<getAny_fileStatus(dc.first)<<std::endl;}
-					if (getAny_fileStatus(dc.first).compare("dangerousContact")!=0 ||
-						getAny_fileStatus(dc.first).compare("reported")!=0){ // if not already reported or already a DC
+					int dcFileStatus = getAny_fileStatus(dc.first);
+if (verbose>1){std::cout<<dc.first->Farm::get_id()<<" is DC/reported? "<<names->name(dcFileStatus)<<std::endl;}
+					if (dcFileStatus != statusDC ||
+						dcFileStatus != statusReported){ // if not already reported or already a DC
 
 						// get current disease status
-						std::string dcDiseaseStatus = getAny_diseaseStatus(dc.first);
+						int dcDiseaseStatus = getAny_diseaseStatus(dc.first);
 
 						// determine if dc should be dangerousContact
-						if (dc.second.count(dcDiseaseStatus)>0){ // dc.second is map with index status, value bool
-							bool isDC = dc.second.at(dcDiseaseStatus);
-	if(verbose>1){std::cout<<"SM::set_status: potential DC "<<dc.first->Farm::get_id()<<" disease status = "<<dcDiseaseStatus<<", isDC = "<<isDC<<std::endl;}
+						if (dcEvaluated & (1u << dcDiseaseStatus)){ // dc.second has a bit for each status
+							bool isDC = dc.second & (1u << dcDiseaseStatus);
+	if(verbose>1){std::cout<<"SM::set_status: potential DC "<<dc.first->Farm::get_id()<<" disease status = "<<names->name(dcDiseaseStatus)<<", isDC = "<<isDC<<std::endl;}
 							bool sourceIsF = 1; // assume source is reported farm unless changed...
-							if (dcDiseaseStatus.compare("sus")!=0){ // if not susceptible, was it exposed by a different farm?
-								sourceIsF = changedStatus.at(dc.first->Farm::get_id())->Prem_status::is_exposureSource(f);
+							if (dcDiseaseStatus != statusSus){ // if not susceptible, was it exposed by a different farm?
+								sourceIsF = changedStatus->find(dc.first)->Prem_status::is_exposureSource(f);
 							}
 	if(verbose>1){std::cout<<"SM::set_status: potential DC "<<dc.first->Farm::get_id()<<"'s source is reported farm? "<<sourceIsF<<std::endl;}
 							if (isDC==1 && sourceIsF==1){
-								changedStatus.at(fid) -> Prem_status::add_DC(dc.first);
-								set_status(dc.first, startTime, "dangerousContact", parameters->dcReportLag);
+								fStatus -> Prem_status::add_DC(dc.first);
+								set_status(dc.first, startTime, statusDC, parameters->dcReportLag);
 							}
 
 							} // end "if status has a corresponding DC outcome"
 					} // end "if not already a DC or reported"
 
 				} // end "for each potential dc"
-				dcsPerIP.emplace_back((changedStatus.at(fid) -> Prem_status::get_dangerousContacts()).size());
+				dcsPerIP.emplace_back((fStatus -> Prem_status::get_dangerousContacts()).size());
 			} // end "if dangerousContacts_on"
 		} // end "if being reported now"
 	}
 
 
 	// if status is a control status (specific to each premises-level control type):
-	if (// first n letters of status are:
-			status.compare(0,11,"implemented")==0 ||
-			status.compare(0,9,"effective")==0 ||
-			status.compare(0,8,"inactive")==0){
+	if (Status_names::isControl(status)){
 
-		if(verbose>1){std::cout<<status<<" (control status)"<<std::endl;}
+		if(verbose>1){std::cout<<names->name(status)<<" (control status)"<<std::endl;}
 
 		// add to appropriate file-status list
-		if (controlStatuses.count(status)==0){
-			controlStatuses[status].lo = 0; // set placeholder at beginning
-		}
-		controlStatuses.at(status).units.emplace_back(changedStatus.at(fid));
-		// get the control type at the end of the status string
-		std::string c_type = status;
-		c_type.replace(0, c_type.find(".")+1, "");
-		std::tuple<double, double> effectiveness = allControlTypes->at(c_type)->effectiveness;
-
-		if (status.compare(0,9,"effective")==0) {
-            changedStatus.at(fid)->Prem_status::add_controlStatus(c_type); // used in detailed output when tx/exp prevented
-            if(c_type == "vax"){
-                changedStatus.at(fid)->vaccinate(std::get<0>(effectiveness)); //For vaccination "effectiveness" is the vaccine efficacy on the animal level and is stored in element 0 of the effectiveness tuple.
-                changedStatus.at(fid)->Prem_status::add_probPreventExposure(0.0); //For vaccination the prevention is not applied as for prem-level control strategies.
-                changedStatus.at(fid)->Prem_status::add_probPreventTransmission(0.0);
+		list = &controlStatuses[status];
+		entry = list->add(fStatus, status);
+		// get the control type of the status
+		int c_type = Status_names::controlTypeOf(status);
+		std::tuple<double, double> effectiveness = get_controlType(c_type)->effectiveness;
+
+		if (Status_names::stageOf(status) == stageEffective) {
+            fStatus->Prem_status::add_controlStatus(c_type); // used in detailed output when tx/exp prevented
+            if(c_type == vaxType){
+                fStatus->vaccinate(std::get<0>(effectiveness)); //For vaccination "effectiveness" is the vaccine efficacy on the animal level and is stored in element 0 of the effectiveness tuple.
+                fStatus->Prem_status::add_probPreventExposure(0.0); //For vaccination the prevention is not applied as for prem-level control strategies.
+                fStatus->Prem_status::add_probPreventTransmission(0.0);
             } else{
-                changedStatus.at(fid)->Prem_status::add_probPreventExposure(std::get<0>(effectiveness));
-                changedStatus.at(fid)->Prem_status::add_probPreventTransmission(std::get<1>(effectiveness));
+                fStatus->Prem_status::add_probPreventExposure(std::get<0>(effectiveness));
+                fStatus->Prem_status::add_probPreventTransmission(std::get<1>(effectiveness));
             }
-		} else if (status.compare(0,8,"inactive")==0) {
-		    if(c_type == "vax"){
-		        changedStatus.at(fid)->unvaccinate();
-				changedStatus.at(fid)->Prem_status::rem_probPreventExposure(0.0);
-				changedStatus.at(fid)->Prem_status::rem_probPreventTransmission(0.0);
+		} else if (Status_names::stageOf(status) == stageInactive) {
+		    if(c_type == vaxType){
+		        fStatus->unvaccinate();
+				fStatus->Prem_status::rem_probPreventExposure(0.0);
+				fStatus->Prem_status::rem_probPreventTransmission(0.0);
 		    } else {
-				changedStatus.at(fid)->Prem_status::rem_probPreventExposure(std::get<0>(effectiveness));
-				changedStatus.at(fid)->Prem_status::rem_probPreventTransmission(std::get<1>(effectiveness));
+				fStatus->Prem_status::rem_probPreventExposure(std::get<0>(effectiveness));
+				fStatus->Prem_status::rem_probPreventTransmission(std::get<1>(effectiveness));
 		    }
 		}
 	}
 
 	// set start and end times
-	changedStatus.at(fid)->Prem_status::set_start(status,startTime);
+	fStatus->Prem_status::set_start(status,startTime);
 	int endTime = startTime+normDelay(statusDuration);
-	changedStatus.at(fid)->Prem_status::set_end(status,endTime);
+	fStatus->Prem_status::set_end(status,endTime);
+	if (list != nullptr && endTime <= parameters->timesteps){ // check for expiry on its end day
+		list->schedule(entry, endTime);
+	}
 }
 
-void Status_manager::set_regionStatus(std::string id, std::string regionType, int startTime, std::string status,
+void Status_manager::set_regionStatus(std::string id, std::string regionType, int startTime, int status,
 	std::tuple<double,double> statusDuration, std::tuple<double,double> controlEffect)
 {
 	// if a Region_status object has not yet been made, make one
@@ -293,40 +310,36 @@ void Status_manager::set_regionStatus(std::string id, std::string regionType, in
 
 	// if lag time = 0, use next status & duration instead
 	while (std::get<0>(statusDuration) == 0){
-		if (statusSequences.at(status).next.compare("NA")!=0){ // if there is a next status
-			status = statusSequences.at(status).next; // overwrite status as the next status
-			statusDuration = statusSequences.at(status).duration; // get duration of that status
+		if (statusSequences[status].next != -1){ // if there is a next status
+			status = statusSequences[status].next; // overwrite status as the next status
+			statusDuration = statusSequences[status].duration; // get duration of that status
 		} else {
 			// leave status as is and set duration to pastEndTime
 			statusDuration = pastEndTime;
 		}
 	}
 
-	if(verbose>1){std::cout<<"SM::set_regionStatus: Setting "<<regionType<<" "<<id<<" status to "<<status
+	if(verbose>1){std::cout<<"SM::set_regionStatus: Setting "<<regionType<<" "<<id<<" status to "<<names->name(status)
 	<<" for "<<std::get<0>(statusDuration)<<" days"<<std::endl;}
 
 	// Disease statuses are not tracked at the region level, only file and control statuses
+	statusList<Region_status*>* list = nullptr; // list that regionStatusPointer is added to
+	unsigned int entry = 0; // entry of regionStatusPointer in list
 
-	if (// first n letters of status are:
-		status.compare(0,11,"implemented")==0 ||
-		status.compare(0,9,"effective")==0 ||
-		status.compare(0,8,"inactive")==0){
+	if (Status_names::isControl(status)){
 
 		regionStatusPointer->Region_status::add_controlStatus(status); // not used for anything, but stored just in case
 		// add to appropriate statusList
-		if (regionControlStatuses.count(status)==0){ // if this is the first region for this status
-			regionControlStatuses[status].lo = 0; // set placeholder at beginning
-		}
-		regionControlStatuses.at(status).units.emplace_back(regionStatusPointer);
-		// get the control type at the end of the status string
-		std::string c_type = status;
-		c_type.replace(0, c_type.find(".")+1, "");
-		std::tuple<double, double> effectiveness = allControlTypes->at(c_type)->effectiveness;
+		list = &regionControlStatuses[status];
+		entry = list->add(regionStatusPointer, status);
+		// get the control type of the status
+		int c_type = Status_names::controlTypeOf(status);
+		std::tuple<double, double> effectiveness = get_controlType(c_type)->effectiveness;
 
-		if (status.compare(0,9,"effective")==0){
+		if (Status_names::stageOf(status) == stageEffective){
 				regionStatusPointer->Region_status::add_probPreventExposure(std::get<0>(effectiveness));
 				regionStatusPointer->Region_status::add_probPreventTransmission(std::get<1>(effectiveness));
-		} else if (status.compare(0,8,"inactive")==0){
+		} else if (Status_names::stageOf(status) == stageInactive){
 				regionStatusPointer->Region_status::rem_probPreventExposure(std::get<0>(effectiveness));
 				regionStatusPointer->Region_status::rem_probPreventTransmission(std::get<1>(effectiveness));
 		}
@@ -336,92 +349,74 @@ void Status_manager::set_regionStatus(std::string id, std::string regionType, in
 	regionStatusPointer->Region_status::set_start(status,startTime);
 	int endTime = startTime+normDelay(statusDuration);
 	regionStatusPointer->Region_status::set_end(status,endTime);
+	if (list != nullptr && endTime <= parameters->timesteps){ // check for expiry on its end day
+		list->schedule(entry, endTime);
+	}
 
 }
 
-/// "Removes" expires farms with a given status and if applicable, sets next status.
+/// "Removes" expires farms with a given status and if applicable, sets next status. Only
+/// farms whose status is scheduled to end at t are checked.
 /// \param[in] t Current timestep, used to determine if statuses have expired and set next status
 /// \param[in] inStatus statusList containing vector of farms and integer placeholder
 /// \param[in] status Status that applies to inStatusList
-void Status_manager::update(int t, std::string status, statusList<Prem_status*>& inStatusList)
+void Status_manager::update(int t, int status, statusList<Prem_status*>& inStatusList)
 {
-	// check from iterator "lo" to end, switch expired farms to before "lo"
-	if (inStatusList.lo < inStatusList.units.size()){ // not all farms have expired
-		std::vector<Prem_status*>::iterator lo_it = inStatusList.units.begin();
-		std::advance(lo_it, inStatusList.lo); // move iterator to lo
-
-		for (auto it = lo_it; it < inStatusList.units.end(); it++){ // check each farm* between lo and end
-				if ( (*it)->Prem_status::get_end(status) == t ){ // if validity of this status expires for this farm today
-				// set to next status
-
-				if (status.compare("exposed")==0){ // specific to file status, not disease
-				// report and add to waitlist for each control type
-					//If we want to add a coin test to determine whether an exposed farm will be reported, then add here
-					if(get_totalPremsWithFileStatus("reported")<1){
-						firstRepTime = t; //if the number of reporteds is less than 1 then record the first reported time.
-
-						if(verbose>1){
-					std::cout << "SM:: First report time recorded as"<< firstRepTime << std::endl;
-						}
-					}
-					set_status(*it, t, "reported", pastEndTime); // in expose(), status was set to expire at report lag
-					report_countyAndState(*it, t); // also report at county and state level
-				} else if (statusSequences.count(status)>0){ // if this status is auto-advanced to another status
-					std::string nextStatus = statusSequences.at(status).next;
-					std::tuple<double, double> statusDuration= statusSequences.at(nextStatus).duration;
-					set_status(*it, t, nextStatus, statusDuration);
-				}
-
-				std::iter_swap(lo_it, it); // switch expired farm into low position
-				lo_it++; // shift lo placemarker forward
-				inStatusList.lo++; // update stored integer to match lo_it position (as integer)
+	inStatusList.takeDue(t, status, dueToday);
+	for (auto& entry:dueToday){
+		Prem_status* ps = inStatusList.units[inStatusList.position[entry]];
+		if (ps->Prem_status::get_end(status) != t){continue;} // status was set again today
+		// set to next status
+
+		if (status == statusExposed){ // specific to file status, not disease
+		// report and add to waitlist for each control type
+			//If we want to add a coin test to determine whether an exposed farm will be reported, then add here
+			if(get_totalPremsWithFileStatus(statusReported)<1){
+				firstRepTime = t; //if the number of reporteds is less than 1 then record the first reported time.
+
+				if(verbose>1){
+			std::cout << "SM:: First report time recorded as"<< firstRepTime << std::endl;
 				}
+			}
+			set_status(ps, t, statusReported, pastEndTime); // in expose(), status was set to expire at report lag
+			report_countyAndState(ps, t); // also report at county and state level
+		} else if (statusSequences[status].next != -1){ // if this status is auto-advanced to another status
+			int nextStatus = statusSequences[status].next;
+			std::tuple<double, double> statusDuration= statusSequences[nextStatus].duration;
+			set_status(ps, t, nextStatus, statusDuration);
 		}
-	} // end "if there are farms in list that haven't expired"
 
+		inStatusList.expire(entry); // switch expired farm into low position
+	}
 }
 
 /// Overloaded for Region_status. Unlike with premises, regions are reported via the
 /// report_countyAndState function.
-void Status_manager::update(int t, std::string status, statusList<Region_status*>& inStatusList)
+void Status_manager::update(int t, int status, statusList<Region_status*>& inStatusList)
 {
-	// check from iterator "lo" to end, switch expired farms to before "lo"
-	if (inStatusList.lo < inStatusList.units.size()){ // not all farms have expired
-		std::vector<Region_status*>::iterator lo_it = inStatusList.units.begin();
-		std::advance(lo_it, inStatusList.lo); // move iterator to lo
-
-		for (auto it = lo_it; it < inStatusList.units.end(); it++){ // check each farm* between lo and end
-				if ( (*it)->Region_status::get_end(status) == t ){ // if validity of this status expires for this farm today
-				// set to next status
-				if (statusSequences.count(status)>0){ // if this status is auto-advanced to another status
-					std::string nextStatus = statusSequences.at(status).next;
-					std::tuple<double, double> duration = statusSequences.at(nextStatus).duration;
-					std::string id = (*it)->Region::get_id();
-					std::string regionType = (*it)->Region::get_type();
-					set_regionStatus(id, regionType, t, nextStatus, duration);
-				}
-				std::iter_swap(lo_it, it); // switch expired region into low position
-				lo_it++; // shift lo placemarker forward
-				inStatusList.lo++; // update stored integer to match lo_it position (as integer)
-				}
+	inStatusList.takeDue(t, status, dueToday);
+	for (auto& entry:dueToday){
+		Region_status* rs = inStatusList.units[inStatusList.position[entry]];
+		if (rs->Region_status::get_end(status) != t){continue;} // status was set again today
+		// set to next status
+		if (statusSequences[status].next != -1){ // if this status is auto-advanced to another status
+			int nextStatus = statusSequences[status].next;
+			std::tuple<double, double> duration = statusSequences[nextStatus].duration;
+			std::string id = rs->Region::get_id();
+			std::string regionType = rs->Region::get_type();
+			set_regionStatus(id, regionType, t, nextStatus, duration);
 		}
-	} // end "if there are farms in list that haven't expired"
-
+		inStatusList.expire(entry); // switch expired region into low position
+	}
 }
 
-
-
 /// Update disease statuses (wrapper for update() function)
 /// \param[in] t Timestep
 void Status_manager::updateDisease(int t)
 {
 	// 'sus'->'exp' transition determined by local spread, shipping, +control
-	if (diseaseStatuses.count("exp")>0){
-		update(t, "exp", diseaseStatuses.at("exp")); // any 'exp' expiring -> 'inf'
-	}
-	if (diseaseStatuses.count("inf")>0){
-	update(t, "inf", diseaseStatuses.at("inf")); // any 'inf' expiring -> 'imm'
-	}
+	update(t, statusExp, diseaseStatuses[statusExp]); // any 'exp' expiring -> 'inf'
+	update(t, statusInf, diseaseStatuses[statusInf]); // any 'inf' expiring -> 'imm'
 	// 'imm' is a permanent status
 }
 
@@ -463,23 +458,24 @@ void Status_manager::update_ControlResources(int t)
 void Status_manager::updateControl(int t)
 {
 	// 'sus'->'exposed' transition determined by local spread, shipping, +control
-	if (fileStatuses.count("exposed")>0){
-		update(t, "exposed", fileStatuses.at("exposed")); // any 'exposed' expiring -> reported+waitlisted
-	}
+	update(t, statusExposed, fileStatuses[statusExposed]); // any 'exposed' expiring -> reported+waitlisted
 	// 'reported' is a permanent status, no updates performed
 
 	// update control statuses
-	for (auto& ct:*allControlTypes){ // should be all control types, including regional
+	for (int ct = 0; ct < names->nControlTypes(); ct++){ // should be all control types, including regional
+		if (controlTypeByID[ct] == nullptr){continue;}
+		int implemented = Status_names::controlStatus(ct, stageImplemented);
+		int effective = Status_names::controlStatus(ct, stageEffective);
 		// 'waitlisted' & 'implemented' transitions determined by controlRules, constraints
-		if (controlStatuses.count("implemented."+ct.first)>0){
-			update(t, "implemented."+ct.first, controlStatuses.at("implemented."+ct.first)); // any 'implemented' expiring -> 'effective'
-		} else if (regionControlStatuses.count("implemented."+ct.first)>0){
-			update(t, "implemented."+ct.first, regionControlStatuses.at("implemented."+ct.first)); // any 'implemented' expiring -> 'effective'
+		if (!controlStatuses[implemented].units.empty()){
+			update(t, implemented, controlStatuses[implemented]); // any 'implemented' expiring -> 'effective'
+		} else if (!regionControlStatuses[implemented].units.empty()){
+			update(t, implemented, regionControlStatuses[implemented]); // any 'implemented' expiring -> 'effective'
 		}
-		if (controlStatuses.count("effective."+ct.first)>0){
-			update(t, "effective."+ct.first, controlStatuses.at("effective."+ct.first)); // any 'effective' expiring -> 'inactive'
-		} else if (regionControlStatuses.count("effective."+ct.first)>0){
-			update(t, "effective."+ct.first, regionControlStatuses.at("effective."+ct.first)); // any 'effective' expiring -> 'inactive'
+		if (!controlStatuses[effective].units.empty()){
+			update(t, effective, controlStatuses[effective]); // any 'effective' expiring -> 'inactive'
+		} else if (!regionControlStatuses[effective].units.empty()){
+			update(t, effective, regionControlStatuses[effective]); // any 'effective' expiring -> 'inactive'
 		}
 		// 'inactive' is a permanent status
 	}
@@ -497,26 +493,19 @@ void Status_manager::updateControl(int t)
 void Status_manager::eval_premExpPrevByVaccination(Farm* ofarm, Farm* dfarm, double trueP, int t,
                                                    bool& transPrevented, bool& expPrevented)
 {
-    int ofid = ofarm->get_id();
-    int dfid = dfarm->get_id();
-
     //First determine which of the farms that are vaccinated.
     bool ofarm_isvaxed = false;
-    Prem_status* opst = nullptr;
-    try{
-        opst = changedStatus.at(ofid);
+    Prem_status* opst = changedStatus->find(ofarm);
+    if(opst != nullptr){ //Just continue if there is no vaccine in effect.
         ofarm_isvaxed = opst->get_isVaccinated();
     }
-    catch(...) {} //Just continue if there is no vaccine in effect.
 
     //Same as above for destination farm.
     bool dfarm_isvaxed = false;
-    Prem_status* dpst = nullptr;
-    try{
-        dpst = changedStatus.at(dfid);
+    Prem_status* dpst = changedStatus->find(dfarm);
+    if(dpst != nullptr){
         dfarm_isvaxed = dpst->get_isVaccinated();
     }
-    catch(...) {}
 
     if(!ofarm_isvaxed and !dfarm_isvaxed)
     {
@@ -626,9 +615,9 @@ void Status_manager::eval_premExpPrevByVaccination(Farm* ofarm, Farm* dfarm, dou
 /// param[in] f Farm* to check
 bool Status_manager::eval_premTransmission(Farm* f){
 	bool output = 1; // by default assume transmission occurs
-	int fid = f->Farm::get_id();
-	if (changedStatus.count(fid)>0){
-		double pNoTransmission = changedStatus.at(fid)->Prem_status::get_probPreventTransmission();
+	Prem_status* fStatus = changedStatus->find(f);
+	if (fStatus != nullptr){
+		double pNoTransmission = fStatus->Prem_status::get_probPreventTransmission();
 		double random = uniform_rand();
 		if (random <= pNoTransmission){  // farm does not become exposed due to control
 			output = 0;
@@ -644,9 +633,9 @@ bool Status_manager::eval_premTransmission(Farm* f){
 bool Status_manager::eval_premExposure(Farm* f){
 
 	bool output = 1; // by default assume exposure occurs
-	int fid = f->Farm::get_id();
-	if (changedStatus.count(fid)>0){
-		double pNotExposed = changedStatus.at(fid)->Prem_status::get_probPreventExposure();
+	Prem_status* fStatus = changedStatus->find(f);
+	if (fStatus != nullptr){
+		double pNotExposed = fStatus->Prem_status::get_probPreventExposure();
 		double random = uniform_rand();
 		if (random <= pNotExposed){  // farm does not become exposed due to control probability
 			output = 0;
@@ -678,10 +667,10 @@ void Status_manager::eval_exposure(int t)
 			add_premSource(t, destination, origin, route, prevented);
 			if(route == 1) //Exposure through shipment
             {
-                Prem_status* origin_prem_status = changedStatus.at(origin->Farm::get_id());
-                if(origin_prem_status->get_diseaseStatus().compare("exp") == 0) //The origin farm is exposed and not infectious yet. The destination farm will inherit the origins' latency to infectiousness.
+                Prem_status* origin_prem_status = changedStatus->find(origin);
+                if(origin_prem_status->get_diseaseStatus() == statusExp) //The origin farm is exposed and not infectious yet. The destination farm will inherit the origins' latency to infectiousness.
                 {
-                    latency_for_this_exposure = origin_prem_status->get_end("exp") - t; //Latency is inherited.
+                    latency_for_this_exposure = origin_prem_status->get_end(statusExp) - t; //Latency is inherited.
                 }
 //                else if(origin_prem_status->get_diseaseStatus().compare('inf') == 0) //Not sure if this should be a feature. Need to decide if bringing infectious animals onto a farm leads to instant infectiousness. /Stefan
 //                {
@@ -729,23 +718,23 @@ void Status_manager::eval_exposure(int t)
 
 			if (!localTransmissionOccurs){
 				if (verbose>1){std::cout<<"Transmission blocked."<<std::endl;}
-				prevented = "src:"+vecToCommaSepString(changedStatus.at(origin->Farm::get_id())->Prem_status::get_controlStatuses()); // determining which of multiple control types could get complicated
+				prevented = "src:"+controlTypeNames(changedStatus->find(origin)->Prem_status::get_controlStatuses()); // determining which of multiple control types could get complicated
 				add_premSource(t, destination, origin, route, prevented);
 			}
 
 			if (!localExposureOccurs){
 				if (verbose>1){std::cout<<"Exposure blocked."<<std::endl;}
-				prevented = "exp:"+vecToCommaSepString(changedStatus.at(destination->Farm::get_id())->Prem_status::get_controlStatuses()); // determining which of multiple control types could get complicated
+				prevented = "exp:"+controlTypeNames(changedStatus->find(destination)->Prem_status::get_controlStatuses()); // determining which of multiple control types could get complicated
 				add_premSource(t, destination, origin, route, prevented);
 			}
 			else if (localTransmissionOccurs && localExposureOccurs){
 				add_premSource(t, destination, origin, route, prevented);
 				if(route == 1) //Exposure through shipment
                 {
-                    Prem_status* origin_prem_status = changedStatus.at(origin->Farm::get_id());
-                    if(origin_prem_status->get_diseaseStatus().compare("exp") == 0) //The origin farm is exposed and not infectious yet. The destination farm will inherit the origins' latency to infectiousness.
+                    Prem_status* origin_prem_status = changedStatus->find(origin);
+                    if(origin_prem_status->get_diseaseStatus() == statusExp) //The origin farm is exposed and not infectious yet. The destination farm will inherit the origins' latency to infectiousness.
                     {
-                        latency_for_this_exposure = origin_prem_status->get_end("exp") - t; //Latency is inherited.
+                        latency_for_this_exposure = origin_prem_status->get_end(statusExp) - t; //Latency is inherited.
                     }
 //                    else if(origin_prem_status->get_diseaseStatus().compare('inf') == 0) //Not sure if this should be a feature. Need to decide if bringing infectious animals onto a farm leads to instant infectiousness. /Stefan
 //                    {
@@ -780,11 +769,11 @@ void Status_manager::filter_shipments(std::vector<Shipment*>& ships, int time)
 	for (auto& s:ships){
 	// fill in fields t, origin, destination
 		s->timestep = time; // set time of shipment
-		Farm* destination = allPrems->at(s->destID);
+		Farm* destination = (*allPrems)[s->destOrdinal];
 
 		// Only evaluate exposure and control if destination is susceptible
-		if (getAny_diseaseStatus(destination).compare("sus")==0){
-			Farm* origin = allPrems->at(s->origID);
+		if (getAny_diseaseStatus(destination) == statusSus){
+			Farm* origin = (*allPrems)[s->origOrdinal];
 			bool exposeDestination = true; // default assumption, control will turn this off
 			// Exposure does NOT happen if shipping bans are effective and realized:
 			if (parameters->control_on == true && allControlTypes->count("shipBan")>0){
@@ -817,13 +806,13 @@ if(verbose>1){std::cout<<"SM::filter_shipments: Shipment prevented by ban"<<std:
 			} // end "if control_on"
 
 			// record exposure source in Prem_status
-			if (changedStatus.count(origin->Farm::get_id())<1){
+			if (changedStatus->find(origin) == nullptr){
 				std::cout<<"ERROR: In Status_manager::filter_shipments: Assumed infectious shipment originated from farm "<<origin->Farm::get_id()<<", but farm not recorded as infectious. Exiting...";
 				Rcpp::stop("");
 			}
 
 			if (!exposeDestination){ // exposure was blocked by shipBan, record, but nothing further will happen with this premises
-				add_premSource(time, destination, changedStatus.at(origin->Farm::get_id()), 1, "shipBan");
+				add_premSource(time, destination, changedStatus->find(origin), 1, "shipBan");
 			} else if (exposeDestination){ // control not on or not realized
 				// evaluate for prem-level control, exposure
 				add_premForEval(destination, origin, 1, 0.0); // stores info temporarily in Prem_status
@@ -847,20 +836,20 @@ void Status_manager::expose(std::vector<std::pair<Farm*, int>>& farms, int t)
         Farm* f = farm_latency_pair.first; //Farm to which to apply status change.
         int explicit_latency = farm_latency_pair.second; //Explicit latency for this exposure.
 		// check if farm is susceptible
-		if (getAny_diseaseStatus(f).compare("sus")==0){
+		if (getAny_diseaseStatus(f) == statusSus){
 		    std::tuple<double, double> latency_parameters = parameters->latencyParams; //Default parameters are those specified in config file
 		    if(explicit_latency > -1) //A specific latency will be used instead of the default.
             {
                 std::get<0>(latency_parameters) = explicit_latency; //Set mean to explicit latency...
                 std::get<1>(latency_parameters) = 0.0; //...and variance to zero.
             }
-			set_status(f,t,"exp",latency_parameters); // disease status
+			set_status(f,t,statusExp,latency_parameters); // disease status
 			if (parameters->control_on == true){
 			// determine time to reporting based on dangerousContact status
-				if (getAny_fileStatus(f).compare("dangerousContact") == 0){
-					set_status(f,t,"exposed",parameters->dcReportLag); // altered report time for DCs
-				} else if (getAny_fileStatus(f).compare("notDangerousContact") == 0){
-					set_status(f,t,"exposed",parameters->nonDCReportLag);
+				if (getAny_fileStatus(f) == statusDC){
+					set_status(f,t,statusExposed,parameters->dcReportLag); // altered report time for DCs
+				} else if (getAny_fileStatus(f) == statusNotDC){
+					set_status(f,t,statusExposed,parameters->nonDCReportLag);
 				}
 			} // end "if control on"
 
@@ -910,25 +899,24 @@ newCoReports.size()<<" new county reports, "<< newStateReports.size()<<" new sta
 	controlManager->check_controlRules(stats, instructions); // writes waitlist info to instructions
 	// add to waitlist according to instructions
 	for (auto& i:instructions){
-		std::string controlType = i.controlType;
+		int ct = names->controlTypeID(i.controlType);
 		std::string controlScale = i.scaleType;
 		if (controlScale.compare("premises")==0){
 			for (auto& f:i.premList){
-				int fid = verify_premStatus(f);
-				Prem_status* premToWL = changedStatus.at(fid);
-				bool alreadyWaitlisted = premToWL->Prem_status::is_onWaitlist(controlType);
+				Prem_status* premToWL = verify_premStatus(f);
+				bool alreadyWaitlisted = premToWL->Prem_status::is_onWaitlist(ct);
 				if (alreadyWaitlisted == 0){
-					waitlist[controlType].emplace_back(f);
+					waitlist[ct].emplace_back(f);
 					if (parameters->dangerousContacts_on==1){
-						std::string fileStatus = getAny_fileStatus(premToWL);
-if(verbose>1){std::cout<<"File status of new waitlist member: "<<fileStatus<<std::endl;}
-						premToWL->Prem_status::set_statusWhenWaitlisted(controlType, fileStatus); // mostly interested in DC vs reported
+						int fileStatus = getAny_fileStatus(premToWL);
+if(verbose>1){std::cout<<"File status of new waitlist member: "<<names->name(fileStatus)<<std::endl;}
+						premToWL->Prem_status::set_statusWhenWaitlisted(ct, fileStatus); // mostly interested in DC vs reported
 					}
 				}
 			}
 		} else if (controlScale.compare("premises")!=0){ // if scale is county or state
 			for (auto& r:i.regionList){ // r is string of region id
-				waitlistRegion[controlType].emplace_back(r);
+				waitlistRegion[ct].emplace_back(r);
 			}
 		}
 	}
@@ -939,11 +927,11 @@ if(verbose>1){std::cout<<"File status of new waitlist member: "<<fileStatus<<std
 	newStateReports.clear();
 
 if (verbose >1){
-	for (auto& c: waitlist){
-	std::cout<< "On waitlist "<<c.first<<": "<<c.second.size()<<" farms"<<std::endl;
+	for (size_t ct = 0; ct < waitlist.size(); ct++){
+	if (!waitlist[ct].empty()){std::cout<< "On waitlist "<<names->controlTypeName(ct)<<": "<<waitlist[ct].size()<<" farms"<<std::endl;}
 	}
-	for (auto& c: waitlistRegion){
-	std::cout<< "On waitlist "<<c.first<<": "<<c.second.size()<<" regions"<<std::endl;
+	for (size_t ct = 0; ct < waitlistRegion.size(); ct++){
+	if (!waitlistRegion[ct].empty()){std::cout<< "On waitlist "<<names->controlTypeName(ct)<<": "<<waitlistRegion[ct].size()<<" regions"<<std::endl;}
 	}
 }
 
@@ -956,163 +944,85 @@ if (verbose >1){
 /// control is implemented for which farms/regions, based on constraint availability
 void Status_manager::add_implemented(int t)
 {
-	for (auto& w:waitlist){ // for each control type (w.first)
-		if (w.second.size()>0){
+	for (size_t ct = 0; ct < waitlist.size(); ct++){ // for each control type
+		std::vector<Farm*>& w = waitlist[ct];
+		if (w.size()>0){
 			std::vector<Farm*> updatedWaitlist;
 			std::vector<Farm*> toImplement;
-			controlManager->filter_constraints(w.first, w.second, updatedWaitlist, toImplement,
+			controlManager->filter_constraints(names->controlTypeName(ct), w, updatedWaitlist, toImplement,
 																				controlResourceLevels, partiallyControlledPrems);
-			w.second = updatedWaitlist;
-			std::tuple<double, double> duration = allControlTypes->at(w.first)->implementDuration;
+			w = updatedWaitlist;
+			std::tuple<double, double> duration = get_controlType(ct)->implementDuration;
 
 			for (auto& i:toImplement){
 				// add to control list & add probPreventExposure values
-				set_status(i, t, "implemented."+w.first, duration);
+				set_status(i, t, Status_names::controlStatus(ct, stageImplemented), duration);
 			}
 		}
 	}
-	for (auto& w:waitlistRegion){ // for each control type (w.first)
-		if (w.second.size()>0){
+	for (size_t ct = 0; ct < waitlistRegion.size(); ct++){ // for each control type
+		std::vector<std::string>& w = waitlistRegion[ct];
+		if (w.size()>0){
 			std::vector<std::string> updatedRegionWaitlist;
 			std::vector<std::string> regionsToImplement;
-			controlManager->filter_constraints(w.first, w.second, updatedRegionWaitlist, regionsToImplement, &controlResourceLevels);
-			w.second = updatedRegionWaitlist;
-			std::tuple<double, double> duration = allControlTypes->at(w.first)->implementDuration;
-			std::string regionType = allControlTypes->at(w.first)->scale;
+			controlManager->filter_constraints(names->controlTypeName(ct), w, updatedRegionWaitlist, regionsToImplement, &controlResourceLevels);
+			w = updatedRegionWaitlist;
+			std::tuple<double, double> duration = get_controlType(ct)->implementDuration;
+			std::string regionType = get_controlType(ct)->scale;
 
 			for (auto& i:regionsToImplement){
 				// add to control list & add probPreventExposure values
-				set_regionStatus(i, regionType, t, "implemented."+w.first, duration);
+				set_regionStatus(i, regionType, t, Status_names::controlStatus(ct, stageImplemented), duration);
 			}
 
 		}
 	}
 }
 
-/// Returns file status of a Prem_status, or "notDangerousContact" if Prem_status does not exist
-std::string Status_manager::getAny_fileStatus(Farm* f) const
+/// Returns file status of a Prem_status, or statusNotDC if Prem_status does not exist
+int Status_manager::getAny_fileStatus(Farm* f) const
 {
-	std::string output;
-	int fid = f->Farm::get_id();
-	if (changedStatus.count(fid)==0){
-		output = "notDangerousContact";
-	} else {
-		output = changedStatus.at(fid)->Prem_status::get_fileStatus();
+	Prem_status* fStatus = changedStatus->find(f);
+	if (fStatus == nullptr){
+		return statusNotDC;
 	}
-	return output;
+	return fStatus->Prem_status::get_fileStatus();
 }
 
-/// Returns disease status of a Prem_status, or "sus" if Prem_status does not exist
-std::string Status_manager::getAny_diseaseStatus(Farm* f) const
+/// Returns disease status of a Prem_status, or statusSus if Prem_status does not exist
+int Status_manager::getAny_diseaseStatus(Farm* f) const
 {
-	std::string output;
-	int fid = f->Farm::get_id();
-	if (changedStatus.count(fid)==0){
-		output = "sus";
-	} else {
-		output = changedStatus.at(fid)->Prem_status::get_diseaseStatus();
+	Prem_status* fStatus = changedStatus->find(f);
+	if (fStatus == nullptr){
+		return statusSus;
 	}
-	return output;
+	return fStatus->Prem_status::get_diseaseStatus();
 }
 
-void Status_manager::get_premsWithStatus(std::vector<std::string> status_vector, std::vector<Farm*>& output)
+/// Output keeps its capacity, so reusing the same vector each timestep rarely allocates.
+/// \param[in] status_vector Disease statuses
+/// \param[out] output Premises currently with each status in turn, in order of list position
+void Status_manager::get_premsWithStatus(const std::vector<int>& status_vector, std::vector<Farm*>& output)
 {
-    std::vector<Farm*> temp_output;
-    for(std::string status : status_vector)
-    {
-        std::vector<Farm*> partial_output;
-        get_premsWithStatus(status, partial_output);
-        temp_output.insert(temp_output.end(), partial_output.begin(), partial_output.end());
-    }
-    output.swap(temp_output);
-}
-
-/// Copies all premises with current disease status s (as of last call to updates) into input vector
-void Status_manager::get_premsWithStatus(std::string s, std::vector<Farm*>& output)
-{
-	if (diseaseStatuses.count(s)==1){
-		std::vector<Farm*> tempOutput;
-		std::vector<Prem_status*>::iterator lo_it = diseaseStatuses.at(s).units.begin() + diseaseStatuses.at(s).lo;
-		std::vector<Prem_status*> outputPS(lo_it, diseaseStatuses.at(s).units.end()); // return farms in [lo, end)
-		for (auto& f:outputPS){
-			tempOutput.emplace_back(allPrems->at(f->Farm::get_id()));
-		}
-		output.swap(tempOutput);
+	output.clear();
+	for (auto& s:status_vector){
+		Prem_view prems = premsWithStatus(s);
+		output.insert(output.end(), prems.begin(), prems.end());
 	}
 }
 
 /// Copies all premises that were status s and DC at time of waitlisting
-int Status_manager::count_allDCPrems(const std::string s)
+int Status_manager::count_allDCPrems(const int s)
 {
 	int dcCount=0;
-	if (controlStatuses.count(s)==1){
-		std::vector<Prem_status*> outputPS(controlStatuses.at(s).units.begin(), controlStatuses.at(s).units.end());
-		// separate c_type from "implemented."
-		std::string c_type = s;
-		c_type.replace(0, c_type.find(".")+1, "");
-		for (auto& f:outputPS){
-			bool wasDC = f->Prem_status::was_dcWhenWaitlisted(c_type);
-			if (wasDC==1){++dcCount;}
-		}
+	int c_type = Status_names::controlTypeOf(s);
+	for (auto& f:controlStatuses[s].units){
+		bool wasDC = f->Prem_status::was_dcWhenWaitlisted(c_type);
+		if (wasDC==1){++dcCount;}
 	}
  return dcCount;
 }
 
-/// Returns number of premises that have ever been disease status s
-int Status_manager::get_totalPremsWithStatus(std::string s)
-{
-	int total = 0;
-	if (s.compare("sus")==0){
-		total = nPrems-1;
-	} else if (diseaseStatuses.count(s)==1){
-		total = diseaseStatuses.at(s).units.size();
-	}
-	return total;
-}
-
-/// Returns current number of premises with disease status s (as of last call to updates)
-int Status_manager::numPremsWithStatus(std::string s)
-{
-	int total = 0;
-	if (s.compare("sus")==0){
-		total = nPrems - notSus.size();
-	} else if (diseaseStatuses.count(s)==1){
-		total = diseaseStatuses.at(s).units.size() - diseaseStatuses.at(s).lo; // number of farms between [lo, end)
-	}
- return total;
-}
-
-/// Returns number of premises that have ever been file status s
-int Status_manager::get_totalPremsWithFileStatus(std::string s)
-{
-	int total = 0;
-	if (fileStatuses.count(s)==1){
-		total = fileStatuses.at(s).units.size();
-	}
-	return total;
-}
-
-
-/// Returns current number of premises with file status s (as of last call to updates)
-int Status_manager::numPremsWithFileStatus(std::string s)
-{
-	int total = 0;
-	if (fileStatuses.count(s)==1){
-		total = fileStatuses.at(s).units.size() - fileStatuses.at(s).lo; // number of farms between [lo, hi]
-	}
- return total;
-}
-
-/// Returns current number of regions with file status s (as of last call to updates)
-int Status_manager::get_numRegionsWithControlStatus(std::string s, std::string regionType)
-{
-	int total = 0;
-	if (regionControlStatuses.count(s)>0){
-		total = regionControlStatuses.at(s).units.size() - regionControlStatuses.at(s).lo;
-	}
- return total;
-}
-
 /// \param[out] Vector of newly not-susceptible farms
 /// Returns farms that became not-susceptible since this function was last called, and
 /// resets placeholder to end to mark the beginning of the next iteration
@@ -1140,14 +1050,14 @@ void Status_manager::get_seedCos(std::vector<std::string>& output)
 }
 /// Add dangerousContacts outcomes to Prem_status (no direct access to Prem_status
 /// from Grid_checker)
-void Status_manager::add_potentialDC(Farm* f1, Farm* f2,
-	std::unordered_map<std::string, bool>& dcEvaluations)
+/// \param[in] dcEvaluations Bit s is set if f2 would be a dangerous contact when in disease status s
+void Status_manager::add_potentialDC(Farm* f1, Farm* f2, unsigned int dcEvaluations)
 {
 	// f1 should already exist in changedStatus since it is infectious
 	if(verbose>1){std::cout<<"SM::Storing "<<f2->Farm::get_id()<<" as possible DC of farm "<<f1->Farm::get_id()<<
-	" with p|sus="<<dcEvaluations.at("sus")<<" and p|exp="<<dcEvaluations.at("exp")<<std::endl;}
+	" with p|sus="<<((dcEvaluations>>statusSus)&1)<<" and p|exp="<<((dcEvaluations>>statusExp)&1)<<std::endl;}
 
-	changedStatus.at(f1->Farm::get_id())->Prem_status::add_potentialDCInfo(f2, dcEvaluations);
+	changedStatus->find(f1)->Prem_status::add_potentialDCInfo(f2, dcEvaluations);
 	if(verbose>1){std::cout<<"SM add_potentialDC after call to premstatus_addpotentialDCINFO"<<std::endl;}
 
 }
@@ -1158,9 +1068,9 @@ std::string Status_manager::formatRepSummary(int rep, int duration, double repTi
     std::unordered_set<County*> affected_counties;
     //Get number of infectious premises and their respective counties.
 	int nInf = 0;
-	if (diseaseStatuses.count("inf")>0)
+	if (!diseaseStatuses[statusInf].units.empty())
     {
-        std::vector<Prem_status*>* all_infectious = &diseaseStatuses.at("inf").units; //Pointer to the vector of all Prem_statuses with status "inf"
+        std::vector<Prem_status*>* all_infectious = &diseaseStatuses[statusInf].units; //Pointer to the vector of all Prem_statuses with status "inf"
         nInf = all_infectious->size();
         for(Prem_status* p : *all_infectious)
         {
@@ -1173,22 +1083,23 @@ std::string Status_manager::formatRepSummary(int rep, int duration, double repTi
 
 	if(parameters->control_on==1){
 		for (auto& ct:(parameters->controlTypes)){
+			int ctID = names->controlTypeID(ct);
 			int implemented = 0;
 			int effective = 0;
-			std::string controlStatusI = "implemented."+ct;
-			if (controlStatuses.count(controlStatusI)>0){
-if(verbose>1){std::cout<<"Total prems with status "<<controlStatusI<<" = "<<controlStatuses.at(controlStatusI).units.size()<<std::endl;}
-				implemented = controlStatuses.at(controlStatusI).units.size();
-			} else if (regionControlStatuses.count(controlStatusI)>0){
-				implemented = regionControlStatuses.at(controlStatusI).units.size();
+			int controlStatusI = Status_names::controlStatus(ctID, stageImplemented);
+			if (!controlStatuses[controlStatusI].units.empty()){
+if(verbose>1){std::cout<<"Total prems with status "<<names->name(controlStatusI)<<" = "<<controlStatuses[controlStatusI].units.size()<<std::endl;}
+				implemented = controlStatuses[controlStatusI].units.size();
+			} else if (!regionControlStatuses[controlStatusI].units.empty()){
+				implemented = regionControlStatuses[controlStatusI].units.size();
 			}
 
-			std::string controlStatusE = "effective."+ct;
-			if (controlStatuses.count(controlStatusE)>0){
-if(verbose>1){std::cout<<"Total prems with status "<<controlStatusE<<" = "<<controlStatuses.at(controlStatusE).units.size()<<std::endl;}
-				effective = controlStatuses.at(controlStatusE).units.size();
-			} else if (regionControlStatuses.count(controlStatusE)>0){
-				effective = regionControlStatuses.at(controlStatusE).units.size();
+			int controlStatusE = Status_names::controlStatus(ctID, stageEffective);
+			if (!controlStatuses[controlStatusE].units.empty()){
+if(verbose>1){std::cout<<"Total prems with status "<<names->name(controlStatusE)<<" = "<<controlStatuses[controlStatusE].units.size()<<std::endl;}
+				effective = controlStatuses[controlStatusE].units.size();
+			} else if (!regionControlStatuses[controlStatusE].units.empty()){
+				effective = regionControlStatuses[controlStatusE].units.size();
 			}
 
 			bool showDcCount = 0;
@@ -1196,13 +1107,13 @@ if(verbose>1){std::cout<<"Total prems with status "<<controlStatusE<<" = "<<cont
 			for (auto&dcType:(parameters->dcControlTypes)){
 				if (dcType == ct){
 					showDcCount = 1;
-					dcCount = count_allDCPrems("implemented."+ct);
+					dcCount = count_allDCPrems(controlStatusI);
 				}
 			}
 			if (effective > implemented){ // only happens when lag from impl->eff is 0, so impl not recorded - fill in here
 				implemented = effective;
 				if (showDcCount==1){
-					dcCount = count_allDCPrems("effective."+ct);
+					dcCount = count_allDCPrems(controlStatusE);
 				}
 			}
 
@@ -1294,19 +1205,36 @@ std::string Status_manager::formatDetails(int rep, int t)
 	return toPrint;
 }
 
-//returns prem staus pointer for corresponding farm id
-Prem_status* Status_manager::get_correspondingPremStatus(int fid)
+/// Exits with an error if control type c_type is not in effect in this simulation
+controlType* Status_manager::get_controlType(int c_type) const
+{
+	if (c_type < 0 || c_type >= int(controlTypeByID.size()) || controlTypeByID[c_type] == nullptr){
+		std::cout<<"ERROR: In Status_manager::get_controlType: control type "<<c_type<<
+		" is not in effect. Exiting..."<<std::endl;
+		Rcpp::stop("");
+	}
+	return controlTypeByID[c_type];
+}
+
+std::string Status_manager::controlTypeNames(const std::vector<int>& c_types) const
+{
+	std::vector<std::string> typeNames;
+	typeNames.reserve(c_types.size());
+	for (auto& ct:c_types){
+		typeNames.emplace_back(names->controlTypeName(ct));
+	}
+	return vecToCommaSepString(typeNames);
+}
+
+//returns prem staus pointer for corresponding farm
+Prem_status* Status_manager::get_correspondingPremStatus(Farm* f)
 {
-    Prem_status* p;
-    //looks for fid in changedStatus
-    // if not found, returns changedStatus.end()
+    //looks for f in changedStatus
     //if found, returns the pointer to prem status object
-    if(changedStatus.find(fid)!=changedStatus.end())
+    Prem_status* p = changedStatus->find(f);
+    if(p == nullptr)
     {
-        p=changedStatus.at(fid);
-
-    }else{
-        std::cout<<"Prem staus for farm ID "<<fid<<" not found in changedStatus. Exiting..."<<std::endl;
+        std::cout<<"Prem staus for farm ID "<<f->Farm::get_id()<<" not found in changedStatus. Exiting..."<<std::endl;
         Rcpp::stop("");
     }
 
@@ -5,25 +5,161 @@
 #include "Control_manager.h"
 #include "Grid_manager.h"
 #include "Shipment_manager.h"
+#include "Prem_status_table.h"
 
 
-#include <iterator> // for std::next
-#include <utility> // for std::iter_swap
+#include <algorithm> // for std::sort
+#include <cstddef> // for std::ptrdiff_t
+#include <iterator> // for std::next, std::forward_iterator_tag
+#include <utility> // for std::iter_swap, std::swap
 
 extern int verboseLevel;
 class Farm;
 class Region_status;
 class Control_resource;
 
-/// Struct containing vector of all farms/regions that have/had a given status, with placeholders to indicate current validity
+/// Struct containing vector of all farms/regions that have/had a given status, with placeholders to indicate current validity.
+/// Each addition of a unit is an entry (numbered in order added); entries are also kept in a
+/// calendar queue by the day their status ends, so that only those due are checked each timestep.
+/// A unit listed more than once expires from all of its entries at its current end time.
 template<typename T>
 struct statusList
 {
 	std::vector<T> units;///< List of all farms/regions with this status, in chronological order of start time
 	unsigned int lo; ///< Before this placeholder, end times are less than t (have already passed)
 	unsigned int hi; ///< After this placeholder, start times are greater than t (have not started yet)
+	std::vector<unsigned int> position; ///< Current position of each entry in units, by entry
+	std::vector<unsigned int> entryAt; ///< Entry at each position in units
+	std::vector<int> previousEntry; ///< Earlier entry of the same unit, by entry (-1 if none)
+	std::vector<std::vector<unsigned int>> due; ///< Entries by day their status ends, until taken on that day
+
+	unsigned int add(T unit, int status); //inlined - adds unit to end of list, returns entry
+	void schedule(unsigned int entry, int day); //inlined - queues entry to be checked on day
+	void takeDue(int t, int status, std::vector<unsigned int>& output); //inlined - entries with status ending at t
+	void expire(unsigned int entry); //inlined - switches entry to before lo
+};
+
+/// Records the new entry as the latest for unit, linked to the unit's earlier entry
+template<typename T>
+inline unsigned int statusList<T>::add(T unit, int status)
+{
+	unsigned int entry = position.size();
+	position.emplace_back(units.size());
+	entryAt.emplace_back(entry);
+	previousEntry.emplace_back(unit->get_listEntry(status));
+	units.emplace_back(unit);
+	unit->set_listEntry(status, entry);
+	return entry;
+}
+template<typename T>
+inline void statusList<T>::schedule(unsigned int entry, int day)
+{
+	if (size_t(day) >= due.size()){due.resize(day+1);}
+	due[day].emplace_back(entry);
+}
+/// Empties the bucket for t. Only each unit's latest entry is scheduled at its current end
+/// time, so other entries in the bucket (superseded by a later addition of the unit) are
+/// skipped, and the unit's unexpired earlier entries are taken with its latest one.
+/// \param[out] output Entries whose status ends at t, in order of position (as a scan of units would find them)
+template<typename T>
+inline void statusList<T>::takeDue(int t, int status, std::vector<unsigned int>& output)
+{
+	output.clear();
+	if (size_t(t) >= due.size()){return;}
+	for (auto& entry:due[t]){
+		if (position[entry] < lo){continue;}
+		T unit = units[position[entry]];
+		if (unit->get_listEntry(status) != int(entry) || unit->get_end(status) != t){continue;}
+		for (int e = entry; e != -1; e = previousEntry[e]){
+			if (position[e] >= lo){output.emplace_back(e);}
+		}
+	}
+	std::vector<unsigned int>().swap(due[t]);
+	std::sort(output.begin(), output.end(),
+		[this](unsigned int a, unsigned int b){return position[a] < position[b];});
+}
+template<typename T>
+inline void statusList<T>::expire(unsigned int entry)
+{
+	unsigned int pos = position[entry];
+	unsigned int lowEntry = entryAt[lo];
+	std::swap(units[lo], units[pos]);
+	position[lowEntry] = pos;
+	entryAt[pos] = lowEntry;
+	position[entry] = lo;
+	entryAt[lo] = entry;
+	lo++;
+}
+
+/// Read-only view of the premises that currently have one status (units in [lo, end) of its
+/// statusList), given as the Farm objects in Grid_manager rather than their Prem_status
+/// copies. The list is read each time the view is used, so it always shows current members
+/// without copying them; iterators are invalidated when premises are added to the list.
+class Prem_view
+{
+	public:
+		/// Iterator giving Farm* for each Prem_status* in the list
+		class iterator
+		{
+			private:
+				Prem_status* const* ps; ///< Position in statusList::units
+				const std::vector<Farm*>* allPrems; ///< Farms by ordinal
+
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef Farm* value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef Farm* const* pointer;
+				typedef Farm* reference;
+
+				iterator(Prem_status* const* in_ps, const std::vector<Farm*>* in_allPrems)
+					: ps(in_ps), allPrems(in_allPrems) {}
+				Farm* operator*() const {return (*allPrems)[(*ps)->Farm::get_ordinal()];}
+				iterator& operator++() {++ps; return *this;}
+				iterator operator++(int) {iterator old = *this; ++ps; return old;}
+				bool operator==(const iterator& other) const {return ps == other.ps;}
+				bool operator!=(const iterator& other) const {return ps != other.ps;}
+		};
+
+		Prem_view(const statusList<Prem_status*>* in_list, const std::vector<Farm*>* in_allPrems);
+		size_t size() const; //inlined
+		bool empty() const; //inlined
+		Farm* operator[](size_t i) const; //inlined - ith current member, in order of list position
+		iterator begin() const; //inlined
+		iterator end() const; //inlined
+
+	private:
+		const statusList<Prem_status*>* list; ///< List of premises ever with the status
+		const std::vector<Farm*>* allPrems; ///< Farms by ordinal
 };
 
+inline Prem_view::Prem_view(const statusList<Prem_status*>* in_list, const std::vector<Farm*>* in_allPrems)
+	:
+	list(in_list),
+	allPrems(in_allPrems)
+{
+}
+inline size_t Prem_view::size() const
+{
+	return list->units.size() - list->lo;
+}
+inline bool Prem_view::empty() const
+{
+	return size() == 0;
+}
+inline Farm* Prem_view::operator[](size_t i) const
+{
+	return (*allPrems)[list->units[list->lo + i]->Farm::get_ordinal()];
+}
+inline Prem_view::iterator Prem_view::begin() const
+{
+	return iterator(list->units.data() + list->lo, allPrems);
+}
+inline Prem_view::iterator Prem_view::end() const
+{
+	return iterator(list->units.data() + list->units.size(), allPrems);
+}
+
 /// Struct defining a transition from one status to the next. A statusShift exists for a status
 /// A that transitions to status B, where 'duration' is the mean and variance of time in days for
 /// A to transition to B, and 'next' is status B. When status A expires, Status_manager::updates()
@@ -31,7 +167,7 @@ struct statusList
 struct statusShift
 {
 	std::tuple<double,double> duration; ///< Mean and variance of duration of status
-	std::string next; ///< Following status
+	int next; ///< ID of following status (see Status_names), -1 if none
 };
 
 /// 	Keeps track of disease and control statuses during a simulation.
@@ -44,12 +180,16 @@ class Status_manager
 		Control_manager* controlManager;
         Grid_manager* gridManager;
 
-		const std::unordered_map<int, Farm*>* allPrems; ///< Pointer to Farms for interfacing with main
+		const std::vector<Farm*>* allPrems; ///< Pointer to Farms for interfacing with main, by ordinal
 		const std::unordered_map<std::string, County*>* allCounties; ///< Pointer to Grid manager's county map
 		const std::unordered_map<std::string, State*>* allStates; ///< Pointer to Grid manager's state map
 		const std::unordered_map<std::string, controlType*>* allControlTypes; ///< Pointer to Control manager's control types
 		const std::unordered_map<std::string, std::unordered_map<std::string, Control_resource*>>* controlResources; ///< Pointer to Control manager's control types
 		const std::unordered_map<std::string, std::unordered_map<int, int>>* controlReleaseSchedule; ///< Pointer to Control manager's control types
+		const Status_names* names; ///< Status and control type IDs, and their names for output
+		std::vector<controlType*> controlTypeByID; ///< Control manager's control types by control type ID (nullptr if not in effect)
+		int vaxType; ///< Control type ID of vaccination, -1 if not used
+		unsigned int dcEvaluated; ///< Bit s is set if dangerous contacts are evaluated for disease status s (config 74)
 
 		unsigned int recentNotSus; ///< Placeholder for last farm that became not-susceptible during the last timestep
 		std::tuple<double, double> pastEndTime; ///< A time lag used for indefinite or permanent statuses
@@ -59,16 +199,17 @@ class Status_manager
 
 		int firstRepTime; //to record first reported time
 
-		std::unordered_map<std::string, statusShift> statusSequences; ///< Statuses that auto-advance to next status and duration of next status, includes disease, file, and control statuses
+		std::vector<statusShift> statusSequences; ///< Next status and its duration for each status ID (next is -1 for permanent statuses), includes disease, file, and control statuses
 
-		std::unordered_map<std::string, statusList<Prem_status*>> fileStatuses; ///< Vectors of farms with particular file statuses, with current validity placeholder
-		std::unordered_map<std::string, statusList<Prem_status*>> diseaseStatuses; ///< Vectors of farms with particular disease statuses, with current validity placeholder
-		std::unordered_map<std::string, statusList<Prem_status*>> controlStatuses; ///< Vectors of farms with particular control statuses, with current validity placeholder
-		std::unordered_map<std::string, statusList<Region_status*>> regionControlStatuses; ///< Vectors of regions with particular control statuses, with current validity placeholder - region statuses only need to be updated for control, disease and file statuses tracked at premises level
+		std::vector<statusList<Prem_status*>> fileStatuses; ///< Vectors of farms with particular file statuses, with current validity placeholder, indexed by status ID
+		std::vector<statusList<Prem_status*>> diseaseStatuses; ///< Vectors of farms with particular disease statuses, with current validity placeholder, indexed by status ID
+		std::vector<statusList<Prem_status*>> controlStatuses; ///< Vectors of farms with particular control statuses, with current validity placeholder, indexed by status ID
+		std::vector<statusList<Region_status*>> regionControlStatuses; ///< Vectors of regions with particular control statuses, with current validity placeholder, indexed by status ID - region statuses only need to be updated for control, disease and file statuses tracked at premises level
+		std::vector<unsigned int> dueToday; ///< Entries of a status list expiring in the current update, reused
 
 		std::vector<std::string> species;
 
-		std::unordered_map<int, Prem_status*> changedStatus; ///< Premises that have had any status change
+		Prem_status_table* changedStatus; ///< Premises that have had any status change, by ordinal (cleared when this replicate ends)
 		std::unordered_map<std::string, Region_status*> changedCoStatus; ///< Counties that have had any status change
 		std::unordered_map<std::string, Region_status*> changedStateStatus; ///< States that have had any status change
 		std::vector<Prem_status*> newPremReports; ///< Starting index for newly reported premises
@@ -81,30 +222,32 @@ class Status_manager
  		std::vector<std::string> reportedCounties;
  		std::vector<std::string> reportedStates;
 		std::vector<std::tuple<Farm*, Farm*, int, double>> exposureForEval; ///< Exposures to be confirmed against control in this timestep(destination, origin, route, probability of exposure)
-		std::unordered_map<std::string, std::vector<Farm*>> waitlist; ///< Waitlists of premises for each control type
-		std::unordered_map<std::string, std::vector<std::string>> waitlistRegion; ///< Waitlists of regions for each control type
+		std::vector<std::vector<Farm*>> waitlist; ///< Waitlists of premises for each control type, by control type ID
+		std::vector<std::vector<std::string>> waitlistRegion; ///< Waitlists of regions for each control type, by control type ID
 		std::vector<int> dcsPerIP;
 
 		std::unordered_map<Control_resource*, int> controlResourceLevels; // availability (keyed by control resource)
 		std::unordered_map<std::string, std::unordered_map<Farm*, int>> partiallyControlledPrems; // key control type, then farm, value is animals remaining to be controlled
 
-		int verify_premStatus(Farm*);
+		Prem_status* verify_premStatus(Farm*);
 		void get_seedCos(std::vector<std::string>&);
-		void set_status(Farm*, int, std::string, std::tuple<double,double>, std::tuple<double, double> controlEffect = std::make_tuple(0,0));
-		void set_regionStatus(std::string id, std::string regionType, int, std::string, std::tuple<double,double>, std::tuple<double, double> controlEffect = std::make_tuple(0,0));
+		void set_status(Farm*, int, int, std::tuple<double,double>, std::tuple<double, double> controlEffect = std::make_tuple(0,0));
+		void set_regionStatus(std::string id, std::string regionType, int, int, std::tuple<double,double>, std::tuple<double, double> controlEffect = std::make_tuple(0,0));
+		controlType* get_controlType(int c_type) const; ///< Control type in effect with ID c_type
+		std::string controlTypeNames(const std::vector<int>& c_types) const; ///< Comma-separated names of control types, for output
 		void report_countyAndState(Farm* f, int t);
 		void eval_premExpPrevByVaccination(Farm* ofarm, Farm* dfarm, double trueP, int t, bool& transPrevented, bool& expPrevented);
 		bool eval_premTransmission(Farm*);
 		bool eval_premExposure(Farm*);
 		void expose(std::vector<std::pair<Farm*, int>>&, int); //Takes a vector of pairs, each pair is the farm to be exposed and the specific latency to be used for this particular exposure.
-		void update(int t, std::string, statusList<Prem_status*>&);
-		void update(int t, std::string, statusList<Region_status*>&);
+		void update(int t, int, statusList<Prem_status*>&);
+		void update(int t, int, statusList<Region_status*>&);
 		void add_premSource(int, Farm*, Farm*, int, std::string); //inlined
-		int count_allDCPrems(const std::string);
+		int count_allDCPrems(const int);
 
 	public:
 		Status_manager(std::vector<Farm*>&, const Parameters*, Grid_manager*,
-		  Control_manager*);
+		  Control_manager*, Prem_status_table*);
 		~Status_manager();
 
 		void add_premForEval(Farm*, Farm*, int, double); //inlined
@@ -113,27 +256,27 @@ class Status_manager
 
 		void eval_exposure(int); // check for control before exposure
 		void filter_shipments(std::vector<Shipment*>&, int); // check shipBans, recipient disease statuses
-		void get_premsWithStatus(std::vector<std::string> status_vector, std::vector<Farm*>& output); // returns vector of Prem_status*s with the statuses provided in the argument status vector
-		void get_premsWithStatus(std::string, std::vector<Farm*>&); // returns vector of Prem_status*s with status
-		int get_totalPremsWithStatus(std::string); // get number of premises _ever_ with this status
-		int numPremsWithStatus(std::string); // get number of Prem_status*s with disease status
-		int numPremsWithFileStatus(std::string s); // get number of Prem_status*s with file status
-		int get_totalPremsWithFileStatus(std::string); // get number of premises _ever_ with this file status status
-		int get_numRegionsWithControlStatus(std::string, std::string);
+		void get_premsWithStatus(const std::vector<int>& status_vector, std::vector<Farm*>& output); // fills output with premises with any of the disease statuses in status_vector
+		Prem_view premsWithStatus(int s) const; //inlined - view of premises currently with disease status s
+		int get_totalPremsWithStatus(int) const; //inlined - get number of premises _ever_ with this status
+		int numPremsWithStatus(int) const; //inlined - get number of premises with disease status
+		int numPremsWithFileStatus(int s) const; //inlined - get number of premises with file status
+		int get_totalPremsWithFileStatus(int) const; //inlined - get number of premises _ever_ with this file status status
+		int get_numRegionsWithControlStatus(int) const; //inlined
  		int get_numCountiesReported() const; //inlined
  		int get_numStatesReported() const; //inlined
 		void newNotSus(std::vector<Farm*>&); //inlined
-		std::string getAny_fileStatus(Farm*) const;
-		std::string getAny_diseaseStatus(Farm*) const; // exists to output "sus" in case of no Prem_status
+		int getAny_fileStatus(Farm*) const;
+		int getAny_diseaseStatus(Farm*) const; // exists to output statusSus in case of no Prem_status
 		std::string formatRepSummary(int, int, double);
 		std::string formatDetails(int, int);
 
 		void add_waitlistMembers(int);
 		void update_ControlResources(int t);
 		void add_implemented(int);
-		void add_potentialDC(Farm*, Farm*, std::unordered_map<std::string, bool>&);
+		void add_potentialDC(Farm*, Farm*, unsigned int);
 
-        Prem_status* get_correspondingPremStatus(int fid);
+        Prem_status* get_correspondingPremStatus(Farm* f);
         const std::unordered_map<std::string, double>& get_normInf_map() const;
         const std::unordered_map<std::string, double>& get_normSus_map() const;
 };
@@ -144,6 +287,42 @@ inline void Status_manager::add_premForEval(Farm* toBeExposed, Farm* exposedBy,
 {
 	exposureForEval.emplace_back(std::make_tuple(toBeExposed, exposedBy, route, trueP));
 }
+/// Current members are those in [lo, end) of the status list (as of last call to updates)
+inline Prem_view Status_manager::premsWithStatus(int s) const
+{
+	return Prem_view(&diseaseStatuses[s], allPrems);
+}
+/// Returns number of premises that have ever been disease status s
+inline int Status_manager::get_totalPremsWithStatus(int s) const
+{
+	if (s == statusSus){
+		return nPrems-1;
+	}
+	return diseaseStatuses[s].units.size();
+}
+/// Returns current number of premises with disease status s (as of last call to updates)
+inline int Status_manager::numPremsWithStatus(int s) const
+{
+	if (s == statusSus){
+		return nPrems - notSus.size();
+	}
+	return diseaseStatuses[s].units.size() - diseaseStatuses[s].lo; // number of farms between [lo, end)
+}
+/// Returns number of premises that have ever been file status s
+inline int Status_manager::get_totalPremsWithFileStatus(int s) const
+{
+	return fileStatuses[s].units.size();
+}
+/// Returns current number of premises with file status s (as of last call to updates)
+inline int Status_manager::numPremsWithFileStatus(int s) const
+{
+	return fileStatuses[s].units.size() - fileStatuses[s].lo; // number of farms between [lo, end)
+}
+/// Returns current number of regions with control status s (as of last call to updates)
+inline int Status_manager::get_numRegionsWithControlStatus(int s) const
+{
+	return regionControlStatuses[s].units.size() - regionControlStatuses[s].lo;
+}
 inline int Status_manager::get_numCountiesReported() const
 {
 	return reportedCounties.size();
@@ -0,0 +1,37 @@
+#include "Status_names.h"
+
+Status_names::Status_names()
+	:
+	names{"sus", "exp", "inf", "imm", "notDangerousContact", "dangerousContact", "exposed", "reported"}
+{
+	for (size_t i = 0; i < names.size(); i++){ids[names[i]] = i;}
+}
+
+/// \param[in] c_type Control type, i.e. "cull" or "vax"
+int Status_names::add_controlType(const std::string& c_type)
+{
+	auto found = controlTypeIDs.find(c_type);
+	if (found != controlTypeIDs.end()){return found->second;}
+	int ctID = controlTypes.size();
+	controlTypes.emplace_back(c_type);
+	controlTypeIDs[c_type] = ctID;
+	for (auto& stage:{"implemented.", "effective.", "inactive."}){
+		ids[stage + c_type] = names.size();
+		names.emplace_back(stage + c_type);
+	}
+	return ctID;
+}
+
+int Status_names::id(const std::string& name) const
+{
+	auto found = ids.find(name);
+	if (found == ids.end()){return -1;}
+	return found->second;
+}
+
+int Status_names::controlTypeID(const std::string& c_type) const
+{
+	auto found = controlTypeIDs.find(c_type);
+	if (found == controlTypeIDs.end()){return -1;}
+	return found->second;
+}
@@ -0,0 +1,109 @@
+#ifndef Status_names_h
+#define Status_names_h
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// IDs of disease statuses (sus to imm) and file statuses (notDangerousContact to
+/// reported). Control statuses follow, see Status_names.
+enum Fixed_status : int
+{
+	statusSus, statusExp, statusInf, statusImm,
+	statusNotDC, statusDC, statusExposed, statusReported,
+	nFixedStatuses
+};
+
+/// Control statuses of each control type, in order
+enum Control_stage : int
+{
+	stageImplemented, stageEffective, stageInactive,
+	nControlStages
+};
+
+/// Interns status names into small integer IDs when the config file is read, so statuses
+/// can be compared and used as array indices during replicates. Disease and file
+/// statuses have the fixed IDs in Fixed_status. Each control type has its own ID, and
+/// its three control statuses ("implemented.", "effective." and "inactive." followed by
+/// the control type) have consecutive IDs after the fixed statuses. Names are only needed
+/// for output and for reading the config file.
+class Status_names
+{
+	private:
+		std::vector<std::string> names; ///< Name of each status, by ID
+		std::vector<std::string> controlTypes; ///< Name of each control type, by control type ID
+		std::unordered_map<std::string, int> ids; ///< ID of each status name
+		std::unordered_map<std::string, int> controlTypeIDs; ///< ID of each control type name
+
+	public:
+		Status_names();
+		int add_controlType(const std::string& c_type); ///< Adds a control type and its control statuses if new, returns its ID
+		int id(const std::string& name) const; ///< ID of a status name, or -1 if unknown
+		int controlTypeID(const std::string& c_type) const; ///< ID of a control type, or -1 if unknown
+		const std::string& name(int status) const; //inlined
+		const std::string& controlTypeName(int c_type) const; //inlined
+		int size() const; //inlined
+		int nControlTypes() const; //inlined
+
+		static bool isDisease(int status); //inlined
+		static bool isFile(int status); //inlined
+		static bool isControl(int status); //inlined
+		static int controlStatus(int c_type, Control_stage stage); //inlined
+		static int controlTypeOf(int status); //inlined
+		static Control_stage stageOf(int status); //inlined
+};
+
+inline const std::string& Status_names::name(int status) const
+{
+	return names[status];
+}
+
+inline const std::string& Status_names::controlTypeName(int c_type) const
+{
+	return controlTypes[c_type];
+}
+
+inline int Status_names::size() const
+{
+	return names.size();
+}
+
+inline int Status_names::nControlTypes() const
+{
+	return controlTypes.size();
+}
+
+inline bool Status_names::isDisease(int status)
+{
+	return status >= statusSus && status <= statusImm;
+}
+
+inline bool Status_names::isFile(int status)
+{
+	return status >= statusNotDC && status <= statusReported;
+}
+
+inline bool Status_names::isControl(int status)
+{
+	return status >= nFixedStatuses;
+}
+
+/// ID of the control status at stage of control type c_type
+inline int Status_names::controlStatus(int c_type, Control_stage stage)
+{
+	return nFixedStatuses + c_type*nControlStages + stage;
+}
+
+/// Control type of a control status
+inline int Status_names::controlTypeOf(int status)
+{
+	return (status - nFixedStatuses)/nControlStages;
+}
+
+/// Stage of a control status
+inline Control_stage Status_names::stageOf(int status)
+{
+	return Control_stage((status - nFixedStatuses)%nControlStages);
+}
+
+#endif // Status_names_h
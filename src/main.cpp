@@ -4,7 +4,12 @@
 
 #include <iostream>
 #include <ctime>
+#include <chrono> // wall-clock replicate timing
 #include <stdlib.h>
+#include <atomic>
+#include <exception> // std::exception_ptr for errors on replicate threads
+#include <mutex>
+#include <thread>
 
 #include "File_manager.h"
 #include "Grid_manager.h"
@@ -56,17 +61,15 @@ int run_usdos(std::string cfile, bool gen_shipment_network = false)
 	std::string str(buffer);
 
 	batchDateTime += str;
-	// write parameters from config file to settings_batchname
-	std::string settingsOutFile = "runlog.txt";
-	// columns are batchDateTime, config lines 1-70, tab-separated
-	std::string printString = fm.getSettings(batchDateTime);
-	printLine(settingsOutFile,printString);
 
 	// set values for global,
 	verboseLevel = p->verboseLevel;
 
 	int verbose = verboseLevel; // override global value for main here if desired
 	int timesteps = p->timesteps;
+if(verbose>0){
+	std::cout << "Random number seed (config 8): " << p->seed << std::endl;
+}
 
 	// Read in farms, determine xylimits
 	std::clock_t loading_start = std::clock();
@@ -86,17 +89,24 @@ int run_usdos(std::string cfile, bool gen_shipment_network = false)
 
 	// Initiate grid...
 	std::clock_t grid_start = std::clock();
-	// if cell file provided, use that
-	if (p->cellFile!="*"){
-		std::string cellFile = p->cellFile;
-		G.initiateGrid(cellFile);} // reading in 730 cells takes ~45 sec
-	// else use uniform params
-	else if (p->uniformSide>0){
-		G.initiateGrid(p->uniformSide);}
-	// else use density params
-	else {
-		G.initiateGrid(p->densityParams.at(0), // max prems per cell
-					   p->densityParams.at(1)); // min cell side}
+	// if a grid cache built from the same inputs exists, use that
+	if (!G.loadGridCache()){
+		// if cell file provided, use that
+		if (p->cellFile!="*"){
+			std::string cellFile = p->cellFile;
+			G.initiateGrid(cellFile);} // reading in 730 cells takes ~45 sec
+		// else use uniform params
+		else if (p->uniformSide>0){
+			G.initiateGrid(p->uniformSide);}
+		// else choose density params automatically
+		else if (p->gridAutoTune==1){
+			G.initiateGrid();}
+		// else use density params
+		else {
+			G.initiateGrid(p->densityParams.at(0), // max prems per cell
+						   p->densityParams.at(1)); // min cell side}
+		}
+		G.saveGridCache(); // for later runs with the same inputs (if config 39 is set)
 	}
 
 	std::clock_t grid_end = std::clock();
@@ -105,6 +115,13 @@ if(verbose>0){
 	std::cout << "CPU time for generating grid: " << gridGenTimeMS << "ms." << std::endl;
 }
 
+	// write parameters from config file to settings_batchname (once the grid is made, to include
+	// parameters chosen automatically)
+	std::string settingsOutFile = "runlog.txt";
+	// columns are batchDateTime, config lines 1-75, grid parameters chosen by config 40, tab-separated
+	std::string printString = fm.getSettings(batchDateTime, G.get_tunedGrid());
+	printLine(settingsOutFile,printString);
+
     if(!gen_shipment_network) //Not making a shipment network, running disease simulation.
     {
         Control_manager Control(p, &G); // pass parameters and Grid_manager pointer
@@ -125,9 +142,66 @@ if(verbose>0){
             if(p->partial==2) std::cout << "bTB like within herd dynamics will be implemented." << std::endl;
         }
 
-    //~~~~~~~~~~~~~~~~~~ Loop starts here
-    for (int r=1; r<=seedFarmsByRun.size(); r++){
-        std::clock_t rep_start = std::clock();
+        int nReps = seedFarmsByRun.size();
+        // Replicates share the (read-only) grid, premises and control settings, each worker
+        // thread gets its own Status_manager, Grid_checker, Shipment_manager and random
+        // number generators.
+        unsigned int nThreads = threadsToUse(p->nThreads);
+        if(nThreads > 1 && p->shipments_on){
+            // shipping parameters are updated in the shared Grid_manager each timestep
+            std::cout << "Warning (config 7): Replicates can not run in parallel when shipments are on (config 41). Running replicates on one thread." << std::endl;
+            nThreads = 1;
+        }
+        if(nThreads > (unsigned int)nReps){nThreads = nReps;}
+        // threads not needed for replicates are used for local spread within each replicate
+        unsigned int spreadThreads = std::max(1u, threadsToUse(p->nThreads)/nThreads);
+if(verbose>0){
+        std::cout << "Running " << nReps << " replicates on " << nThreads << " thread(s)";
+        if(spreadThreads > 1){std::cout << ", local spread on " << spreadThreads << " thread(s) per replicate";}
+        std::cout << "." << std::endl;
+}
+        std::mutex outputMutex; // serializes writing to the summary and detail files
+
+        // write output file headers before any replicate starts
+        if (p->printDetail > 0){
+            std::string detOutFile = batchDateTime;
+            detOutFile += "_detail.txt";
+            std::string header = "Rep\tExposedID\tatTime\tSourceID\tInfRoute\tControlPrevented\tExposedCounty\tSourceCounty\n";
+            printLine(detOutFile,header);
+        }
+        if (p->printSummary > 0){
+            std::string sumOutFile = batchDateTime;
+            sumOutFile += "_summary.txt";
+            std::string header = "Rep\tNum_Inf\tnAffCounties\tDuration\tSeed_Farms\tSeed_FIPS\tRunTimeSec";
+            if (p->control_on == 1){
+            for(auto& ct:(p->controlTypes)){
+            	std::string ctString = "\t"+ct+"Implemented";
+            	ctString += "\t"+ct+"Effective";
+            	header+=ctString;
+            	for(auto& dct:(p->dcControlTypes)){
+            		if (dct==ct){
+            			std::string dcImp = "\t"+ct+"ImplementedDCSubset";
+									header+=dcImp;
+            		}
+            	}
+
+            }
+            }
+            if (p->dangerousContacts_on == 1){
+								std::string meandc = "\tmeanDCsPerRP";
+								header+=meandc;
+							}
+            header+="\n";
+            printLine(sumOutFile,header);
+        }
+
+    //~~~~~~~~~~~~~~~~~~ Replicate (runs on a worker thread)
+    auto runReplicate = [&](int r, Prem_status_table& statusTable){
+        std::chrono::steady_clock::time_point rep_start = std::chrono::steady_clock::now();
+        // each replicate draws from its own stream, split from the master stream by replicate
+        // number, so results don't depend on which thread runs it
+        Rng_stream repStream = Rng_stream::master().split(r);
+        Rng_binding bindStream(&repStream);
         // load initially infected farms and instantiate Status manager
         // note that initial farms are started as exposed
     	std::vector<Farm*> seedFarms = seedFarmsByRun[r-1];
@@ -138,9 +212,9 @@ if(verbose>0){
         }
 
 
-        Status_manager Status(seedFarms, p, &G, &Control); // seeds initial exposures, provides parameters, grid, control
+        Status_manager Status(seedFarms, p, &G, &Control, &statusTable); // seeds initial exposures, provides parameters, grid, control
         Shipment_manager Ship(fipsmap, fipsSpeciesMap, &Status, p->shipPremAssignment, p->species, p); // modify to pass grid manager, p
-        Grid_checker gridCheck(allCells, &Status, p);
+        Grid_checker gridCheck(allCells, &Status, p, spreadThreads);
         // control resources
 
         Population_manager Pop(&Status, p);//initialise Pop manager
@@ -156,7 +230,7 @@ if(verbose>0){
         {
             G.initShippingParameters(1, rep_start_day);
         }
-        std::vector<Farm*> focalFarms; //Stores infectious farms for the local spread component.
+        Prem_view focalFarms = Status.premsWithStatus(statusInf); //Current infectious farms for the local spread component.
         std::vector<Farm*> focalFarmsShipments; //Stores both infectious and exposed premises for the shipment component.
         bool potentialTx = 1;
 
@@ -185,17 +259,16 @@ if(verbose>1){
                 std::cout << "Control statuses updated" << std::endl;
 }
                 }
-                Status.get_premsWithStatus("inf", focalFarms);	// set focalFarms as all farms with disease status inf
                 Status.get_premsWithStatus(p->statuses_to_generate_shipments_from, focalFarmsShipments); //Build the set of farms to generate shipments from.
 
 if(verbose>0){
                 std::cout <<"Timestep "<<t<<": "
-                <<Status.numPremsWithStatus("sus")<<" susceptible, "
-                <<Status.numPremsWithStatus("exp")<<" exposed, "
+                <<Status.numPremsWithStatus(statusSus)<<" susceptible, "
+                <<Status.numPremsWithStatus(statusExp)<<" exposed, "
                 <<focalFarms.size()<<" infectious, "
-                <<Status.numPremsWithStatus("imm")<<" immune premises. "<<std::endl;
+                <<Status.numPremsWithStatus(statusImm)<<" immune premises. "<<std::endl;
                 if (p->control_on == true){
-                    std::cout << Status.numPremsWithFileStatus("reported") << " reported premises in "
+                    std::cout << Status.numPremsWithFileStatus(statusReported) << " reported premises in "
                     <<Status.get_numCountiesReported()<<" counties and "
                     <<Status.get_numStatesReported()<<" state(s)."<<std::endl;
                 }
@@ -247,10 +320,9 @@ if(verbose>0){
                 Status.add_implemented(t);
                 if(verbose>1){std::cout << "SM: add_implemented" << std::endl;}
 
-                // at the end of this transmission day, statuses are now...
-                Status.get_premsWithStatus("inf", focalFarms); // assign "inf" farms as focalFarms
-                int numSuscept = Status.numPremsWithStatus("sus");
-                int numExposed = Status.numPremsWithStatus("exp");
+                // at the end of this transmission day, statuses are now... (focalFarms is a view, so already current)
+                int numSuscept = Status.numPremsWithStatus(statusSus);
+                int numExposed = Status.numPremsWithStatus(statusExp);
 
                 //if bTB like infection is on
                 if(p->partial==2){
@@ -270,17 +342,14 @@ if(verbose>0){
                     // rep, ID, time, sourceID, route, prevented
                     std::string detOutFile = batchDateTime;
                     detOutFile += "_detail.txt";
-                    if (r==1 && t==1){
-                        std::string header = "Rep\tExposedID\tatTime\tSourceID\tInfRoute\tControlPrevented\tExposedCounty\tSourceCounty\n";
-                        printLine(detOutFile,header);
-                    }
                     std::string printString = Status.formatDetails(r,t);
+                    std::lock_guard<std::mutex> lock(outputMutex);
                     printLine(detOutFile, printString);
                 }
 
                 potentialTx = ((focalFarms.size()>0 && numSuscept>0) || (numExposed>0 && numSuscept>0));
                 if (p->useMaxPrems==1){
-                    int totalInf = Status.get_totalPremsWithStatus("inf");
+                    int totalInf = Status.get_totalPremsWithStatus(statusInf);
                     if (totalInf > p->maxInfectiousPrems){
                         potentialTx = 0;
                     }
@@ -293,46 +362,54 @@ if(verbose>0){
 }
         }  	// end "while under time and exposed/infectious and susceptible farms remain"
 
-        std::clock_t rep_end = std::clock();
-        double repTimeMS = 1000.0 * (rep_end - rep_start) / CLOCKS_PER_SEC;
-        std::cout << "CPU time for batch "<<batchDateTime<<", seed source #"<<r<<" of "
-        <<seedFarmsByRun.size()<<" ("<<t<<" timesteps): " << repTimeMS << "ms." << std::endl;
+        std::chrono::steady_clock::time_point rep_end = std::chrono::steady_clock::now();
+        double repTimeMS = std::chrono::duration<double, std::milli>(rep_end - rep_start).count();
+        std::cout << "Time for batch "<<batchDateTime<<", seed source #"<<r<<" of "
+        <<nReps<<" ("<<t<<" timesteps): " << repTimeMS << "ms." << std::endl;
 
         if (p->printSummary > 0){
             // output summary to file (rep, days inf, run time)
             // rep, # farms infected, # days of infection, seed farm and county, run time
             std::string sumOutFile = batchDateTime;
             sumOutFile += "_summary.txt";
-            if (r==1){
-                std::string header = "Rep\tNum_Inf\tnAffCounties\tDuration\tSeed_Farms\tSeed_FIPS\tRunTimeSec";
-                if (p->control_on == 1){
-                for(auto& ct:(p->controlTypes)){
-                	std::string ctString = "\t"+ct+"Implemented";
-                	ctString += "\t"+ct+"Effective";
-                	header+=ctString;
-                	for(auto& dct:(p->dcControlTypes)){
-                		if (dct==ct){
-                			std::string dcImp = "\t"+ct+"ImplementedDCSubset";
-											header+=dcImp;
-                		}
-                	}
-
-                }
-                }
-                if (p->dangerousContacts_on == 1){
-									std::string meandc = "\tmeanDCsPerRP";
-									header+=meandc;
-								}
-                header+="\n";
-                printLine(sumOutFile,header);
-            }
             std::string repOut = Status.formatRepSummary(r,t,repTimeMS);
+            std::lock_guard<std::mutex> lock(outputMutex);
             printLine(sumOutFile,repOut);
             }
 if(verbose>0){
             std::cout << "Replicate "<< r << " complete." << std::endl<< std::endl;
 }
-    } // end for loop
+    }; // end replicate
+
+    // Worker threads claim replicates in order until none are left. An error in one
+    // replicate stops the remaining ones and is passed on once all threads have joined.
+    std::atomic<int> nextRep(1);
+    std::exception_ptr repError = nullptr;
+    std::mutex errorMutex;
+    auto worker = [&](){
+        // premises statuses are reused by each replicate this thread runs
+        Prem_status_table statusTable(G.get_allFarms_vector().size());
+        int r;
+        while ((r = nextRep++) <= nReps){
+            try {
+                runReplicate(r, statusTable);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!repError){repError = std::current_exception();}
+                nextRep = nReps+1;
+            }
+        }
+    };
+    if (nThreads <= 1){
+        worker();
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int i = 0; i < nThreads; i++){
+            workers.emplace_back(worker);
+        }
+        for (auto& w:workers){w.join();}
+    }
+    if (repError){std::rethrow_exception(repError);}
 } // End if !gen_shipment_network
 else if(gen_shipment_network)
 {
@@ -1,29 +1,32 @@
 #include "shared_functions.h"
 #include "Farm.h"
 #include <iterator>
-
+#include <thread> // std::thread::hardware_concurrency
+#ifdef _WIN32
+#include <process.h> // _getpid
+#else
+#include <unistd.h> // getpid
+#endif
+
+/// Draws from the stream bound to the calling thread (see Rng_stream)
 double uniform_rand()
 {
-	static std::uniform_real_distribution<double> unif_dist(0.0, 1.0);
-	static unsigned int seed = std::chrono::system_clock::now().time_since_epoch().count();
-	static std::mt19937 generator(seed); //Mersenne Twister pseudo-random number generator. Generally considered research-grade.
-	return unif_dist(generator);
+	return Rng_stream::current().uniform();
+}
+
+void uniform_rand(double* out, size_t n)
+{
+	Rng_stream::current().uniform(out, n);
 }
 
 double normal_rand()
 {
-	static std::normal_distribution<double> norm_dist(0,1);
-	static unsigned int seed = std::chrono::system_clock::now().time_since_epoch().count();
-	static std::mt19937 generator(seed); //Mersenne Twister pseudo-random number generator. Generally considered research-grade.
-	return norm_dist(generator);
+	return Rng_stream::current().normal();
 }
 
 int rand_int(int lo, int hi)
 {
-	std::uniform_int_distribution<int> unif_dist(lo, hi);
-	unsigned long long int seed = std::chrono::system_clock::now().time_since_epoch().count();
-	std::mt19937 generator(seed); //Mersenne Twister pseudo-random number generator. Generally considered research-grade.
-	return unif_dist(generator);
+	return Rng_stream::current().integer(lo, hi);
 }
 
 /// Used in gridding (binomial method) to determing # of infected farms
@@ -32,26 +35,100 @@ int rand_int(int lo, int hi)
 int draw_binom(int N, double prob)
 // draw from a binomial distribution based on N farms and prob (calc with focalInf & gridKern)
 {
-	std::binomial_distribution<int> binom_dist(N,prob);
-	static unsigned int seed = std::chrono::system_clock::now().time_since_epoch().count();
-	static std::mt19937 generator(seed); //Mersenne Twister pseudo-random number generator. Generally considered research-grade.
-	return binom_dist(generator);
+	return Rng_stream::current().binom(N, prob);
+}
+
+/// Gives the same distribution as n calls to draw_binom, with the uniform numbers for all
+/// pairs drawn first (most pairs in local spread have tiny probabilities, and give 0)
+/// \param[in]	N	Numbers of trials
+/// \param[in]	prob	Probabilities of success
+/// \param[out]	out	Numbers of successes
+/// \param[in]	n	Number of (N, prob) pairs
+void draw_binom(const int* N, const double* prob, int* out, size_t n)
+{
+	Rng_stream::current().binom(N, prob, out, n);
+}
+
+/// Linear probing from a multiplicative hash of the position
+size_t& Position_set::find(size_t position)
+{
+	size_t slot = size_t((position * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	while (slots[slot] != 0 && slots[slot] != position+1){slot = (slot+1) & mask;}
+	return slots[slot];
+}
+
+/// Uses Robert Floyd's algorithm, so memory and time depend on k rather than n (used
+/// where n is a number of pairs of premises). Positions are in the order chosen.
+/// \param[in]	n	Number of positions to choose from
+///	\param[in]	k	Number of positions to choose (at most n)
+/// \param[out] output	Chosen positions
+/// \param[in,out] chosen	Reusable set, empty before and after the call (grown to at least 2k slots if needed)
+void sample_positions(size_t n, size_t k, std::vector<size_t>& output, Position_set& chosen)
+{
+	output.clear();
+	if (k > n){k = n;}
+	if (chosen.slots.size() < 2*k){
+		size_t nSlots = 16;
+		while (nSlots < 2*k){nSlots *= 2;}
+		chosen.slots.assign(nSlots, 0);
+		chosen.mask = nSlots-1;
+	}
+	for (size_t j = n-k; j < n; j++){
+		size_t r = (size_t)(uniform_rand()*(j+1)); // in [0, j]
+		if (r > j){r = j;}
+		size_t* slot = &chosen.find(r);
+		if (*slot != 0){ // already chosen, take j instead (never chosen before)
+			r = j;
+			slot = &chosen.find(r);
+		}
+		*slot = r+1;
+		output.emplace_back(r);
+	}
+	// empty the slots in reverse order, so no later position was placed past an emptied slot
+	for (size_t i = output.size(); i-- > 0;){chosen.find(output[i]) = 0;}
+}
+
+/// Makes the same choices as random_unique on a vector of positions 0 to n-1, without
+/// copying anything: the choices are swaps within permutation (kept between calls as 0,
+/// 1, 2...), which are undone afterwards. Allocates only if n is larger than in earlier calls.
+/// \param[in]	n	Number of positions to choose from
+///	\param[in]	k	Number of positions to choose (at most n)
+/// \param[out] output	Chosen positions, in the order chosen
+/// \param[in,out] permutation	Reusable array, grown to n elements if needed
+void sample_positions(size_t n, size_t k, std::vector<size_t>& output, std::vector<size_t>& permutation)
+{
+	if (k > n){k = n;}
+	while (permutation.size() < n){permutation.emplace_back(permutation.size());}
+	output.resize(k);
+	// endIndex separates non-selected positions (permutation[0, endIndex-1]) from selected ones
+	for (size_t i = 0; i < k; i++){
+		size_t endIndex = n - i;
+		double rUnif = uniform_rand();
+		size_t r = (size_t)(rUnif*endIndex);
+		if (r >= endIndex){r = endIndex-1;}
+		std::swap(permutation[r], permutation[endIndex-1]);
+		output[i] = r; // swap position, replaced by chosen position below
+	}
+	// later swaps are all below n-1-i, so permutation[n-1-i] is still the i-th choice
+	for (size_t i = k; i-- > 0;){
+		size_t r = output[i];
+		output[i] = permutation[n-1-i];
+		std::swap(permutation[r], permutation[n-1-i]);
+	}
 }
 
 /// Used to generate the number of shipments that originate from a state in a given timestep.
 /// \param[in] lambda Rate of distribution.
 int draw_poisson(double lambda)
 {
-    std::poisson_distribution<int> p_dist(lambda);
-	static unsigned int seed = std::chrono::system_clock::now().time_since_epoch().count();
-	static std::mt19937 generator(seed); //Mersenne Twister pseudo-random number generator. Generally considered research-grade.
-	return p_dist(generator);
+	return Rng_stream::current().poisson(lambda);
 }
 
-
+/// Seeds for other generators (gsl_rng) are drawn from the calling thread's stream, so
+/// they are reproducible given the config seed.
 unsigned int generate_distribution_seed()
 {
-    return std::chrono::system_clock::now().time_since_epoch().count();
+    return Rng_stream::current().draw_seed();
 }
 
 size_t get_day_of_year(size_t current_timestep, size_t start_day)
@@ -295,3 +372,43 @@ unsigned int get_n_lines(std::ifstream& f)
     f.seekg(0, f.beg);
     return n_lines;
 }
+
+unsigned int threadsToUse(int requested)
+{
+	unsigned int nThreads = requested;
+	if (requested <= 0){
+		nThreads = std::thread::hardware_concurrency();
+		if (nThreads == 0){nThreads = 1;}
+	}
+	return nThreads;
+}
+
+/// Used to tell whether inputs have changed since a cache file was written
+unsigned long long hashBytes(const char* data, size_t length, unsigned long long hash)
+{
+	for (size_t i = 0; i < length; i++){
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+unsigned long long hashFile(const std::string& fname, unsigned long long hash)
+{
+	std::ifstream f(fname, std::ios::binary);
+	if (!f){return hashBytes(fname.data(), fname.size(), hash);}
+	std::vector<char> buffer(1 << 20);
+	while (f.read(buffer.data(), buffer.size()) || f.gcount() > 0){
+		hash = hashBytes(buffer.data(), f.gcount(), hash);
+	}
+	return hash;
+}
+
+int processID()
+{
+#ifdef _WIN32
+	return _getpid();
+#else
+	return getpid();
+#endif
+}
@@ -15,13 +15,28 @@
 #include <Rcpp.h>
 
 #include "Farm.h"
+#include "Rng_stream.h"
+
+/// Set of positions reused by sample_positions, so choosing positions doesn't allocate once
+/// the table is large enough. Open addressing: each slot holds a position plus 1, or 0 if
+/// empty. Slots are emptied again before sample_positions returns.
+struct Position_set
+{
+	std::vector<size_t> slots; ///< Number of slots is 0 or a power of 2
+	size_t mask = 0; ///< Number of slots - 1
+	size_t& find(size_t position); ///< Slot holding position, or the empty slot where it would go
+};
 
 	double uniform_rand(); ///< Uniform distribution random number generator
+	void uniform_rand(double* out, size_t n); ///< Fills out with n uniform random numbers
 	double normal_rand(); ///< Normal distribution random number generator
 	int rand_int(int lo, int hi); ///< Uniform integer distribution rng.
 	int draw_binom(int, double); ///< Draw number of successes from a binomial distribution
+	void draw_binom(const int* N, const double* prob, int* out, size_t n); ///< Draws numbers of successes for n (N, prob) pairs at once
+	void sample_positions(size_t n, size_t k, std::vector<size_t>& output, Position_set& chosen); ///< Chooses k different positions in [0, n) without listing all n
+	void sample_positions(size_t n, size_t k, std::vector<size_t>& output, std::vector<size_t>& permutation); ///< Chooses k different positions in [0, n) using a reusable permutation
 	int draw_poisson(double lambda); ///<Generate a random number from a poisson dist. with given rate.
-	unsigned int generate_distribution_seed(); ///<Generates a number that can be used in a random number generator based on the current time.
+	unsigned int generate_distribution_seed(); ///<Generates a number that can be used to seed another random number generator.
 	size_t get_day_of_year(size_t current_timestep, size_t start_day); ///<Given the current time step and the start day of the simulation, returns the current day of the year.
 	double oneMinusExp(double); ///< Calculates \f$1 - e^x\f$ using a two-term Taylor approximation for x<1e-5
  	int normDelay(std::tuple<double, double>&); ///< Return a period of time, drawn from a normal distribution
@@ -42,6 +57,10 @@
 	void addItemTab(std::string&, std::string); ///< Overloaded version adds tab after a string
 	void printLine(std::string&, std::string&); ///< Generic print function used by a variety of output files
 	unsigned int get_n_lines(std::ifstream& f); ///< Counts and returns the number of lines in a file.
+	unsigned int threadsToUse(int requested); ///< Number of threads to run for a config 7 value (0 = all available cores)
+	unsigned long long hashBytes(const char* data, size_t length, unsigned long long hash = 14695981039346656037ULL); ///< 64-bit FNV-1a hash, continues from a previous hash if given
+	unsigned long long hashFile(const std::string& fname, unsigned long long hash); ///< Continues a hash with the contents of a file (or its name if it can't be opened)
+	int processID(); ///< ID of this process, used to name temporary files
 
 template<typename T>
 T stringToNum(const std::string& text)
@@ -99,7 +118,7 @@ void random_unique(std::vector<T> elements, int num_random, std::vector<T>& outp
 
 ///> Checks if an item is within a vector of items
 template<typename T>
-bool isWithin(const T target, const std::vector<T> vec)
+bool isWithin(const T target, const std::vector<T>& vec)
 {
 	auto it = vec.begin();
 	bool found = 0;
@@ -153,4 +172,45 @@ inline bool sortByID(const T item1, const T item2)
 	return (item1 -> get_id()) < (item2 -> get_id());
 }
 
+///> Writes a plain value to a binary stream
+template<typename T>
+void writeBinary(std::ostream& out, const T& value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+///> Writes a vector of plain values to a binary stream, preceded by its length
+template<typename T>
+void writeBinaryVec(std::ostream& out, const std::vector<T>& vec)
+{
+	unsigned long long length = vec.size();
+	writeBinary(out, length);
+	if (length > 0){out.write(reinterpret_cast<const char*>(vec.data()), length*sizeof(T));}
+}
+
+///> Reads a plain value written by writeBinary, returns false if the stream ran out
+template<typename T>
+bool readBinary(std::istream& in, T& value)
+{
+	in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return bool(in);
+}
+
+///> Reads a vector written by writeBinaryVec, returns false if the stream ran out or
+/// the stored length is longer than the rest of the stream
+template<typename T>
+bool readBinaryVec(std::istream& in, std::vector<T>& vec)
+{
+	unsigned long long length = 0;
+	if (!readBinary(in, length)){return false;}
+	std::streampos here = in.tellg();
+	in.seekg(0, in.end);
+	unsigned long long remaining = in.tellg() - here;
+	in.seekg(here);
+	if (length > remaining/sizeof(T)){in.setstate(std::ios::failbit); return false;}
+	vec.resize(length);
+	if (length > 0){in.read(reinterpret_cast<char*>(vec.data()), length*sizeof(T));}
+	return bool(in);
+}
+
 #endif